@@ -31,13 +31,22 @@
 
 #include <map>
 #include <string>
+#include <memory>
+#include <istream>
+#include <limits>
 #include <stdexcept>
 
 #include "cpphoafparser/parser/hoa_parser_exception.hh"
 
 namespace cpphoafparser {
 
-/** Lexer for tokenizing a HOA stream (used internally by HOAParser). */
+/**
+ * Lexer for tokenizing a HOA stream (used internally by HOAParser).
+ *
+ * The input is read in blocks (or given as one block in memory), and runs
+ * of whitespace, digits, identifier characters and string characters are
+ * scanned directly in the current block.
+ */
 class HOALexer {
 public:
   /** The type of the tokens in a HOA stream. */
@@ -246,20 +255,15 @@ public:
   };
 
   /** Constructor for a lexer, reading from the given input stream. */
-  HOALexer(std::istream& in) 
-  : in(in), line(1), col(0), ch(0) {
-    // The headers we know
-    knownHeaders["HOA:"] = TOKEN_HOA;    
-    knownHeaders["State:"] = TOKEN_STATE;
-    knownHeaders["States:"] = TOKEN_STATES;
-    knownHeaders["Start:"] = TOKEN_START;
-    knownHeaders["AP:"] = TOKEN_AP;
-    knownHeaders["Alias:"] = TOKEN_ALIAS;
-    knownHeaders["Acceptance:"] = TOKEN_ACCEPTANCE;
-    knownHeaders["acc-name:"] = TOKEN_ACCNAME;
-    knownHeaders["tool:"] = TOKEN_TOOL;
-    knownHeaders["name:"] = TOKEN_NAME;
-    knownHeaders["properties:"] = TOKEN_PROPERTIES;
+  HOALexer(std::istream& in)
+  : in(&in), buffer(new char[bufferSize]), start(nullptr), pos(nullptr), last(nullptr), line(1), col(0), ch(0) {
+    initKnownHeaders();
+  }
+
+  /** Constructor for a lexer, reading the `size` characters at `data` (which have to outlive the lexer). */
+  HOALexer(const char* data, std::size_t size)
+  : in(nullptr), start(data), pos(data), last(data + size), line(1), col(0), ch(0) {
+    initKnownHeaders();
   }
 
   /** Get the next token from the input stream. */
@@ -333,6 +337,10 @@ public:
       std::string text(1, (char)ch);
       bool last_was_quote = false;
       while (true) {
+        if (!last_was_quote) {
+          // the characters up to the next quote or backslash are taken as they are
+          scanRun(text, [](char c) {return c != '"' && c != '\\';});
+        }
         nextChar();
         if (ch == EOF) {throw error("Premature end-of-file in quoted string", lineStart, colStart);}
         text+=(char)ch;
@@ -350,55 +358,34 @@ public:
     // handle integers
     if (ch >= '0' && ch <= '9') {
       std::string text(1, (char)ch);
-      while (true) {
-        int next = peekChar();
-        if (next >= '0' && next <= '9') {
-          nextChar();
-          text+=(char)ch;
-        } else {
-          break;
-        }
-      }
+      scanRun(text, [](char c) {return c >= '0' && c <= '9';});
 
       if (text.at(0)=='0' && text.length() > 1) {
         throw error("Syntax error parsing integer, starts with 0: "+text, lineStart, colStart);
       }
 
-      try {
-        unsigned int vInteger = std::stoi(text);
-        return Token(vInteger, lineStart, colStart);
-      } catch (std::invalid_argument& e) {
-        throw error("Syntax error: "+text+" is not an integer", lineStart, colStart);
-      } catch (std::out_of_range& e) {
-        throw error("Syntax error: integer "+text+" is too big to represent as an unsigned int", lineStart, colStart);
+      // the value has to fit into an int (as for std::stoi)
+      unsigned long long value = 0;
+      for (char c : text) {
+        value = 10 * value + (c - '0');
+        if (value > (unsigned long long)std::numeric_limits<int>::max()) {
+          throw error("Syntax error: integer "+text+" is too big to represent as an unsigned int", lineStart, colStart);
+        }
       }
+      return Token((unsigned int)value, lineStart, colStart);
 
     } else if (ch == '@' || ch == '_' || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')) {
       // handle identifiers, @alias-names, headers, t and f
       std::string text(1, (char)ch);
 
       bool alias = (ch == '@');
-      while (true) {
-        int next = peekChar();
-        if (next == EOF) break;
-        if (next == ':') {
-          if (alias) break;
-          // consume ':'
-          nextChar();
-          text+=':';
-          break;
-        }
-        if (next == '_' ||
-            next == '-' ||
-            (next >= 'a' && next <= 'z') ||
-            (next >= 'A' && next <= 'Z') ||
-            (next >= '0' && next <= '9')) {
-          nextChar();
-          text+=(char)ch;
-          continue;
-        } else {
-          break;
-        }
+      scanRun(text, [](char c) {
+        return c == '_' || c == '-' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+      });
+      if (!alias && peekChar() == ':') {
+        // consume ':'
+        nextChar();
+        text+=':';
       }
 
       if (alias) {
@@ -423,11 +410,40 @@ public:
     throw error("Syntax error, illegal character '"+std::string(1, (char)ch)+"'", lineStart, colStart);
   }
 
+  /** The number of chars read so far (only for input in memory) */
+  std::size_t offset() const {
+    return pos - start;
+  }
+
 private:
+  /** Register the headers we know */
+  void initKnownHeaders() {
+    // The headers we know
+    knownHeaders["HOA:"] = TOKEN_HOA;    
+    knownHeaders["State:"] = TOKEN_STATE;
+    knownHeaders["States:"] = TOKEN_STATES;
+    knownHeaders["Start:"] = TOKEN_START;
+    knownHeaders["AP:"] = TOKEN_AP;
+    knownHeaders["Alias:"] = TOKEN_ALIAS;
+    knownHeaders["Acceptance:"] = TOKEN_ACCEPTANCE;
+    knownHeaders["acc-name:"] = TOKEN_ACCNAME;
+    knownHeaders["tool:"] = TOKEN_TOOL;
+    knownHeaders["name:"] = TOKEN_NAME;
+    knownHeaders["properties:"] = TOKEN_PROPERTIES;
+  }
 
   /** Skip whitespace. */
   void skip() {
     while (true) {
+      // skip the run of whitespace in the current block
+      for (; pos != last && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r'); pos++) {
+        if (*pos == '\n' || *pos == '\r') {
+          line++;
+          col=0;
+        } else {
+          col++;
+        }
+      }
       nextChar();
       if (ch == EOF) { // EOF
         return;
@@ -492,17 +508,48 @@ private:
     }
   }
 
+  /** Read the next block of the input stream, returns false at the end of the input */
+  bool fill() {
+    if (!in) return false;
+    std::streamsize n = in->rdbuf()->sgetn(buffer.get(), bufferSize);
+    if (n <= 0) return false;
+    pos = buffer.get();
+    last = pos + n;
+    return true;
+  }
+
   /** Read the next char in the input stream, store in `ch` */
   void nextChar() {
-    ch = in.get();
-    if (ch != EOF) {
-      col++;
+    if (pos == last && !fill()) {
+      ch = EOF;
+      return;
     }
+    ch = (unsigned char)*pos++;
+    col++;
   }
 
   /** Peek at the next char in the input stream without consuming */
   int peekChar() {
-    return in.peek();
+    if (pos == last && !fill()) {
+      return EOF;
+    }
+    return (unsigned char)*pos;
+  }
+
+  /** Append the longest run of the next chars satisfying `accept` to `text` (without newlines) */
+  template <typename Accept>
+  void scanRun(std::string& text, Accept accept) {
+    while (pos != last || fill()) {
+      const char* first = pos;
+      while (pos != last && *pos != '\n' && *pos != '\r' && accept(*pos)) {
+        pos++;
+      }
+      text.append(first, pos);
+      col += pos - first;
+      if (pos != last) {
+        return;
+      }
+    }
   }
 
   /**
@@ -516,8 +563,17 @@ private:
   }
 
 private:
-  /** The input stream */
-  std::istream& in;
+  /** The input stream (nullptr for input in memory) */
+  std::istream* in;
+  /** The size of the blocks read from the input stream */
+  static constexpr std::size_t bufferSize = 1 << 16;
+  /** The current block of the input stream */
+  std::unique_ptr<char[]> buffer;
+  /** The first char of the input in memory */
+  const char* start;
+  /** The chars of the current block that are not read yet */
+  const char* pos;
+  const char* last;
   /** The current line number */
   unsigned int line;
   /** The current column number */
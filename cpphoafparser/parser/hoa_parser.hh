@@ -76,17 +76,81 @@ public:
    *        These are checks beyond the basic syntactic well-formedness guaranteed by the grammar.
    **/
   static void parse(std::istream& in, HOAConsumer::ptr consumer, bool check_validity=true) {
+    HOAParser parser(HOALexer(in), chain(consumer, check_validity));
+    parser.nextToken();
+    parser.Automaton();
+  }
+
+  /**
+   * Function for parsing a single HOA automaton from memory (e.g., a mapped file).
+   *
+   * @param data the first character of the automaton
+   * @param size the number of characters after `data` that may be read
+   * @param consumer a shared_ptr to the HOAConsumer whose functions will
+   *        be called for each element of the HOA automaton
+   * @param check_validity Should the validity of the HOA be checked?
+   *        If the input is trusted, the tokens are passed straight to
+   *        the consumer (unless it needs the aliases to be resolved).
+   **/
+  static void parse(const char* data, std::size_t size, HOAConsumer::ptr consumer, bool check_validity=true) {
+    HOAParser parser(HOALexer(data, size), chain(consumer, check_validity));
+    parser.nextToken();
+    parser.Automaton();
+  }
+
+  /**
+   * Function for parsing the header of a HOA automaton from memory, up to and
+   * including --BODY--, without validity checks. The body can then be parsed
+   * in blocks of State: definitions with parseStates (e.g., concurrently,
+   * with one consumer per block).
+   *
+   * @param data the first character of the automaton
+   * @param size the number of characters after `data` that may be read
+   * @param consumer a shared_ptr to the HOAConsumer whose functions will
+   *        be called for each element of the header (it may not require the
+   *        aliases to be resolved)
+   * @return the number of characters up to the end of --BODY--
+   **/
+  static std::size_t parseHeader(const char* data, std::size_t size, HOAConsumer::ptr consumer) {
     if (consumer->parserResolvesAliases()) {
-      consumer.reset(new HOAIntermediateResolveAliases(consumer));
+      throw std::logic_error("HOAParser::parseHeader does not resolve aliases");
     }
-
-    if (check_validity) {
-      consumer.reset(new HOAIntermediateCheckValidity(consumer));
+    HOAParser parser(HOALexer(data, size), consumer);
+    parser.nextToken();
+    parser.Header();
+    if (parser.token.kind != HOALexer::TOKEN_BODY) {
+      throw parser.error(HOALexer::Token::forErrorMessage(HOALexer::TOKEN_BODY));
     }
+    consumer->notifyBodyStart();
+    return parser.lexer.offset();
+  }
 
-    HOAParser parser(in, consumer);
+  /**
+   * Function for parsing a block of State: definitions of the body of a HOA
+   * automaton from memory (see parseHeader), without validity checks.
+   *
+   * @param data the first character of the block (the beginning of a State: definition)
+   * @param size the number of characters of the block
+   * @param consumer a shared_ptr to the HOAConsumer whose functions will
+   *        be called for each element of the block
+   * @param last true if the block is the end of the body, which has to end
+   *        with --END--; the other blocks end at the end of their characters
+   **/
+  static void parseStates(const char* data, std::size_t size, HOAConsumer::ptr consumer, bool last) {
+    HOAParser parser(HOALexer(data, size), consumer);
     parser.nextToken();
-    parser.Automaton();
+    parser.Body();
+    if (last) {
+      parser.expect(HOALexer::TOKEN_END);
+    } else if (parser.token.kind != HOALexer::TOKEN_EOF) {
+      throw parser.error("either State: or the end of the block");
+    }
+    if (parser.inState) {
+      consumer->notifyEndOfState(parser.currentState);
+    }
+    if (last) {
+      consumer->notifyEnd();
+    }
   }
 
 private:
@@ -106,8 +170,20 @@ private:
 
 
   /** Private constructor. */
-  HOAParser(std::istream& in, HOAConsumer::ptr consumer) :
-    consumer(consumer), lexer(in), inState(false), currentState(0), currentStateHasStateLabel(false) {
+  HOAParser(HOALexer lexer, HOAConsumer::ptr consumer) :
+    consumer(consumer), lexer(std::move(lexer)), inState(false), currentState(0), currentStateHasStateLabel(false) {
+  }
+
+  /** The consumer with the intermediate consumers needed in front of it. */
+  static HOAConsumer::ptr chain(HOAConsumer::ptr consumer, bool check_validity) {
+    if (consumer->parserResolvesAliases()) {
+      consumer.reset(new HOAIntermediateResolveAliases(consumer));
+    }
+
+    if (check_validity) {
+      consumer.reset(new HOAIntermediateCheckValidity(consumer));
+    }
+    return consumer;
   }
 
   /** Advance to the next token. Handles TOKEN_ABORT */
@@ -0,0 +1,146 @@
+/*
+ * Class: ColorIndex
+ *
+ *  Class formalizing the vertices of a game bucketed by their colors (and the colors of an objective)
+ */
+
+#ifndef COLORINDEX_HPP_
+#define COLORINDEX_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <span>
+#include <limits>
+#include <algorithm>
+
+#include "VertexSet.hpp"
+
+namespace mpa {
+/* class for the colors of the vertices of an objective: the colors of a vector or of a packed column of
+ * a ColorMatrix, or the colors of the {0,1,2}-objective of parityToMultigame with odd color threshold_
+ * computed on the fly from these colors (so that an objective costs no memory of its own) */
+class ColorMap {
+public:
+    /* colors of the vertices (indexed by dense ids), stored with width_ bytes per color */
+    const void* data_;
+    size_t width_;
+    /* number of colors */
+    size_t size_;
+    /* odd color of the objective (0 if the colors are not changed) */
+    size_t threshold_;
+public:
+    /* colors of the vector */
+    ColorMap(const std::vector<size_t>& colors, const size_t threshold = 0):
+        data_(colors.data()), width_(sizeof(size_t)), size_(colors.size()), threshold_(threshold) {}
+
+    /* colors of a packed column (data points to size colors of type uint8_t, uint16_t or uint32_t) */
+    ColorMap(const void* data, const size_t width, const size_t size, const size_t threshold = 0):
+        data_(data), width_(width), size_(size), threshold_(threshold) {}
+
+    /* color of vertex v */
+    size_t operator[](const size_t v) const {
+        return threshold_ == 0 ? stored(v) : threshold_color(stored(v), threshold_);
+    }
+
+    /* stored color of vertex v */
+    size_t stored(const size_t v) const {
+        switch (width_){
+            case 1: return static_cast<const uint8_t*>(data_)[v];
+            case 2: return static_cast<const uint16_t*>(data_)[v];
+            case 4: return static_cast<const uint32_t*>(data_)[v];
+            default: return static_cast<const size_t*>(data_)[v];
+        }
+    }
+
+    /* if there are no colors (e.g. for multigames) */
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /* colors of all vertices in a vector */
+    std::vector<size_t> to_vector() const {
+        std::vector<size_t> colors(size_);
+        for (size_t v = 0; v < size_; v++){
+            colors[v] = (*this)[v];
+        }
+        return colors;
+    }
+
+    /* color in the objective with odd color odd_col of a vertex with color c: 0 for the colors below
+     * odd_col, 2 for the even colors above odd_col, and 1 otherwise */
+    static size_t threshold_color(const size_t c, const size_t odd_col) {
+        if (c < odd_col){
+            return 0;
+        }
+        return (c == odd_col || c % 2 == 1) ? 1 : 2;
+    }
+}; /* close class definition */
+
+/* class for the buckets of vertices with the same color (built once and shared by all subgames) */
+class ColorIndex {
+public:
+    /* marker for the vertices that are left out */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /* maximum of colors */
+    size_t max_color_;
+    /* vertices with color c are bucket_[bucket_begin_[c]],...,bucket_[bucket_begin_[c+1]-1] (sorted) */
+    std::vector<size_t> bucket_begin_;
+    std::vector<size_t> bucket_;
+public:
+    /* buckets of the given vertices (all buckets are empty if there are no colors, e.g. for multigames) */
+    ColorIndex(const ColorMap& colors, const VertexSet& vertices): max_color_(0) {
+        if (colors.empty()){
+            bucket_begin_.assign(2, 0);
+            return;
+        }
+        for (auto v : vertices){
+            max_color_ = std::max(max_color_, colors[v]);
+        }
+        bucket_begin_.assign(max_color_+2, 0);
+        for (auto v : vertices){
+            bucket_begin_[colors[v]+1] += 1;
+        }
+        for (size_t c = 0; c <= max_color_; c++){
+            bucket_begin_[c+1] += bucket_begin_[c];
+        }
+        bucket_.resize(vertices.size());
+        std::vector<size_t> fill(bucket_begin_.begin(), bucket_begin_.end()-1);
+        for (auto v : vertices){
+            bucket_[fill[colors[v]]++] = v;
+        }
+    }
+
+    /* buckets of the vertices of parent renumbered by position (the vertices with position npos are left out) */
+    ColorIndex(const ColorIndex& parent, const std::vector<size_t>& position): max_color_(parent.max_color_) {
+        bucket_begin_.assign(max_color_+2, 0);
+        for (size_t c = 0; c <= max_color_; c++){
+            for (auto v : parent.bucket(c)){
+                if (position[v] != npos){
+                    bucket_.push_back(position[v]);
+                }
+            }
+            std::sort(bucket_.begin() + bucket_begin_[c], bucket_.end());
+            bucket_begin_[c+1] = bucket_.size();
+        }
+    }
+
+    /* vertices with color c */
+    std::span<const size_t> bucket(const size_t c) const {
+        if (c > max_color_){
+            return std::span<const size_t>();
+        }
+        return std::span<const size_t>(bucket_.data() + bucket_begin_[c], bucket_.data() + bucket_begin_[c+1]);
+    }
+
+    /* vertices with color c among first,...,last-1 */
+    std::span<const size_t> bucket(const size_t c, const size_t first, const size_t last) const {
+        std::span<const size_t> all = bucket(c);
+        auto begin = std::lower_bound(all.begin(), all.end(), first);
+        auto end = std::lower_bound(begin, all.end(), last);
+        return std::span<const size_t>(begin, end);
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * Class: ColorMatrix
+ *
+ *  Class formalizing the colors of all objectives of a multigame packed in contiguous columns
+ */
+
+#ifndef COLORMATRIX_HPP_
+#define COLORMATRIX_HPP_
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "ColorIndex.hpp"
+
+namespace mpa {
+/* class for the colors of the objectives (columns) of a multigame: the column of every stored objective
+ * is a contiguous array of the colors of all vertices (indexed by dense ids), and all columns have the
+ * smallest width (1, 2 or 4 bytes per color) of the largest color; a column can also be left unstored
+ * (for objectives whose colors are computed on the fly, see ColorMap) */
+class ColorMatrix {
+public:
+    /* marker for the columns that are not stored */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /* number of vertices (rows) */
+    size_t n_vert_;
+    /* number of bytes per color */
+    size_t width_;
+    /* the i-th column starts at offset_[i] of the colors (npos if it is not stored) */
+    std::vector<size_t> offset_;
+    /* colors of the stored columns (only the vector of width_ is used) */
+    std::vector<uint8_t> data8_;
+    std::vector<uint16_t> data16_;
+    std::vector<uint32_t> data32_;
+public:
+    /* n_cols columns of n_vert colors 0 */
+    explicit ColorMatrix(const size_t n_vert = 0, const size_t n_cols = 0): n_vert_(n_vert), width_(1) {
+        for (size_t i = 0; i < n_cols; i++){
+            add_column();
+        }
+    }
+
+    /* number of columns */
+    size_t size() const {
+        return offset_.size();
+    }
+
+    /* number of bytes of the stored colors */
+    size_t bytes() const {
+        return n_stored() * n_vert_ * width_;
+    }
+
+    /* if the i-th column is stored */
+    bool stored(const size_t i) const {
+        return offset_[i] != npos;
+    }
+
+    /* color of vertex v in the i-th column */
+    size_t get(const size_t i, const size_t v) const {
+        return column(i).stored(v);
+    }
+
+    /* colors of the i-th column */
+    ColorMap column(const size_t i) const {
+        return ColorMap(data() + offset_[i] * width_, width_, n_vert_);
+    }
+
+    /* colors of the i-th column in a vector */
+    std::vector<size_t> to_vector(const size_t i) const {
+        return column(i).to_vector();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Operators
+    ///////////////////////////////////////////////////////////////
+
+    /* remove all columns */
+    void clear(){
+        *this = ColorMatrix();
+    }
+
+    /* add a column with color fill for every vertex (wide enough for the colors up to max_color) */
+    void add_column(const size_t fill = 0, const size_t max_color = 0){
+        widen(std::max(fill, max_color));
+        offset_.push_back(n_stored() * n_vert_);
+        resize(n_stored() * n_vert_);
+        for (size_t v = 0; v < n_vert_; v++){
+            set(size()-1, v, fill);
+        }
+    }
+
+    /* add a column with the given colors */
+    void add_column(const std::vector<size_t>& colors){
+        offset_.push_back(npos);
+        store(size()-1, colors);
+    }
+
+    /* add a column that is not stored */
+    void add_view(){
+        offset_.push_back(npos);
+    }
+
+    /* store the given colors as the i-th column */
+    void store(const size_t i, const std::vector<size_t>& colors){
+        if (n_vert_ == 0 && !colors.empty()){ /* the first nonempty column gives the number of vertices */
+            n_vert_ = colors.size();
+            size_t k = 0;
+            for (auto& offset : offset_){
+                if (offset != npos){
+                    offset = (k++) * n_vert_;
+                }
+            }
+            resize(k * n_vert_);
+        }
+        if (colors.size() != n_vert_){
+            throw std::runtime_error("[ERROR] ColorMatrix: the number of colors is different from the number of vertices.");
+        }
+        widen(colors.empty() ? 0 : *std::max_element(colors.begin(), colors.end()));
+        if (!stored(i)){
+            offset_[i] = n_stored() * n_vert_;
+            resize(n_stored() * n_vert_);
+        }
+        for (size_t v = 0; v < n_vert_; v++){
+            set(i, v, colors[v]);
+        }
+    }
+
+    /* set the color of vertex v in the (stored) i-th column to c */
+    void set(const size_t i, const size_t v, const size_t c){
+        widen(c);
+        switch (width_){
+            case 1: data8_[offset_[i] + v] = static_cast<uint8_t>(c); break;
+            case 2: data16_[offset_[i] + v] = static_cast<uint16_t>(c); break;
+            default: data32_[offset_[i] + v] = static_cast<uint32_t>(c); break;
+        }
+    }
+
+private:
+    /* number of stored columns */
+    size_t n_stored() const {
+        return std::count_if(offset_.begin(), offset_.end(), [](const size_t offset){ return offset != npos; });
+    }
+
+    /* first byte of the stored colors */
+    const uint8_t* data() const {
+        switch (width_){
+            case 1: return data8_.data();
+            case 2: return reinterpret_cast<const uint8_t*>(data16_.data());
+            default: return reinterpret_cast<const uint8_t*>(data32_.data());
+        }
+    }
+
+    /* number of stored colors */
+    size_t n_colors() const {
+        switch (width_){
+            case 1: return data8_.size();
+            case 2: return data16_.size();
+            default: return data32_.size();
+        }
+    }
+
+    /* change the number of stored colors (the new colors are 0) */
+    void resize(const size_t n){
+        switch (width_){
+            case 1: data8_.resize(n, 0); break;
+            case 2: data16_.resize(n, 0); break;
+            default: data32_.resize(n, 0); break;
+        }
+    }
+
+    /* repack the colors with a width large enough for color c */
+    void widen(const size_t c){
+        size_t width = c <= std::numeric_limits<uint8_t>::max() ? 1 : (c <= std::numeric_limits<uint16_t>::max() ? 2 : 4);
+        if (c > std::numeric_limits<uint32_t>::max()){
+            throw std::runtime_error("[ERROR] ColorMatrix: colors larger than 2^32-1 are not supported.");
+        }
+        if (width <= width_){
+            return;
+        }
+        std::vector<size_t> colors(n_colors());
+        for (size_t k = 0; k < colors.size(); k++){
+            colors[k] = ColorMap(data(), width_, colors.size()).stored(k);
+        }
+        data8_ = std::vector<uint8_t>();
+        data16_ = std::vector<uint16_t>();
+        width_ = width;
+        if (width_ == 2){
+            data16_.assign(colors.begin(), colors.end());
+        }
+        else {
+            data32_.assign(colors.begin(), colors.end());
+        }
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Class: ConflictIndex
+ *
+ *  Class formalizing the edges of a template indexed by their sources (for detecting conflicts)
+ */
+
+#ifndef CONFLICTINDEX_HPP_
+#define CONFLICTINDEX_HPP_
+
+#include <vector>
+#include <set>
+#include <cstdint>
+
+#include "Graph.hpp"
+#include "Template.hpp"
+#include "VertexSet.hpp"
+
+namespace mpa {
+/* class for the colive edges and the live groups of a template grouped by their sources: built once
+ * and then every conflict is found by looking only at the sources in the template (the graph and the
+ * template have to outlive the index and must not change) */
+class ConflictIndex {
+public:
+    /* graph of the template */
+    const Graph* graph_;
+    /* if the edge with id e is colive */
+    std::vector<uint8_t> colive_;
+    /* number of colive edges of every vertex */
+    std::vector<size_t> colive_count_;
+    /* edges of live groups from vertex v are the runs run_[run_begin_[v]],...,run_[run_begin_[v+1]-1]:
+     * every run is the range of edges of one live group with source v */
+    std::vector<size_t> run_begin_;
+    std::vector<std::pair<const size_t*, const size_t*>> run_;
+    /* vertices with colive edges or edges of live groups (increasing) */
+    std::vector<size_t> sources_;
+public:
+    /* index of the colive edges and the live groups of strat */
+    ConflictIndex(const Graph& graph, const Template& strat): graph_(&graph) {
+        colive_.assign(graph.edge_ends_->size(), 0);
+        colive_count_.assign(graph.n_vert_, 0);
+        for (auto e : strat.colive_edges_){
+            colive_[e] = 1;
+            colive_count_[graph.edge_source(e)] += 1;
+        }
+        /* count the runs of every source and place them in their rows */
+        run_begin_.assign(graph.n_vert_+1, 0);
+        for_each_run(strat, [&](const size_t v, const size_t*, const size_t*){
+            run_begin_[v+1] += 1;
+        });
+        for (size_t v = 0; v < graph.n_vert_; v++){
+            run_begin_[v+1] += run_begin_[v];
+        }
+        run_.resize(run_begin_[graph.n_vert_]);
+        std::vector<size_t> fill(run_begin_.begin(), run_begin_.end()-1);
+        for_each_run(strat, [&](const size_t v, const size_t* first, const size_t* last){
+            run_[fill[v]++] = std::make_pair(first, last);
+        });
+        for (size_t v = 0; v < graph.n_vert_; v++){
+            if (colive_count_[v] != 0 || run_begin_[v] != run_begin_[v+1]){
+                sources_.push_back(v);
+            }
+        }
+    }
+
+    /* call f(v, first, last) for every maximal range [first,last) of edges of a live group with source v */
+    template<class F>
+    void for_each_run(const Template& strat, F f) const {
+        for (const auto& live_group : strat.live_groups_){
+            const size_t* first = live_group->data();
+            const size_t* end = first + live_group->size();
+            while (first != end){
+                size_t v = graph_->edge_source(*first);
+                const size_t* last = first;
+                while (last != end && graph_->edge_source(*last) == v){
+                    ++last;
+                }
+                f(v, first, last);
+                first = last;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Conflicts
+    ///////////////////////////////////////////////////////////////
+
+    /* function: colive_conflicts
+     *
+     * add the vertices of the winning region whose edges are all colive, or whose edges in some
+     * live group are all colive, to colive_vertices */
+    void colive_conflicts(const VertexSet& winning, std::set<size_t>& colive_vertices) const {
+        std::vector<uint8_t> conflict(sources_.size(), 0);
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (size_t k = 0; k < sources_.size(); k++){
+            size_t v = sources_[k];
+            if (!winning.contains(v)){
+                continue;
+            }
+            /* all edges of v are colive */
+            if (colive_count_[v] != 0 && colive_count_[v] == graph_->out_degree(v)){
+                conflict[k] = 1;
+                continue;
+            }
+            /* all edges of v in a live group are colive */
+            for (size_t r = run_begin_[v]; r < run_begin_[v+1] && colive_count_[v] != 0; r++){
+                if (std::all_of(run_[r].first, run_[r].second, [&](const size_t e){ return colive_[e] != 0; })){
+                    conflict[k] = 1;
+                    break;
+                }
+            }
+        }
+        for (size_t k = 0; k < sources_.size(); k++){
+            if (conflict[k]){
+                colive_vertices.insert(colive_vertices.end(), sources_[k]);
+            }
+        }
+    }
+
+    /* function: unsafe_conflict
+     *
+     * check if a vertex of the winning region has only colive edges (or edges to the losing region),
+     * or only such edges in some live group */
+    bool unsafe_conflict(const VertexSet& winning, const VertexSet& losing) const {
+        /* if an edge is colive or leads to the losing region */
+        auto blocked = [&](const size_t e){
+            return colive_[e] != 0 || losing.contains(graph_->edge_target(e));
+        };
+        bool conflict = false;
+        #pragma omp parallel for schedule(dynamic, 64) reduction(||:conflict)
+        for (size_t k = 0; k < sources_.size(); k++){
+            size_t v = sources_[k];
+            if (conflict || !winning.contains(v)){
+                continue;
+            }
+            /* every edge of v outside the losing region is colive (and there is one) */
+            if (colive_count_[v] != 0){
+                bool outside = false; /* if v has an edge outside the losing region */
+                bool blocked_all = true;
+                for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1] && blocked_all; i++){
+                    if (!losing.contains(graph_->succ_[i])){
+                        outside = true;
+                        blocked_all = colive_[graph_->edge_id(i)] != 0;
+                    }
+                }
+                if (outside && blocked_all){
+                    conflict = true;
+                    continue;
+                }
+            }
+            /* every edge of v in a live group is blocked */
+            for (size_t r = run_begin_[v]; r < run_begin_[v+1]; r++){
+                if (std::all_of(run_[r].first, run_[r].second, blocked)){
+                    conflict = true;
+                    break;
+                }
+            }
+        }
+        return conflict;
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
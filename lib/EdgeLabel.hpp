@@ -0,0 +1,104 @@
+/*
+ * Class: EdgeLabel, EdgeLabels
+ *
+ *  Classes formalizing the labels of the edge-states (mid-states) of hoa games packed in (care, value) bit masks
+ */
+
+#ifndef EDGELABEL_HPP_
+#define EDGELABEL_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace mpa {
+/* literals of an atomic proposition in a label */
+enum Literal : size_t { NEG = 0, POS = 1, ANY = 2 };
+
+/* number of words of the masks of n_ap atomic propositions */
+inline size_t label_words(const size_t n_ap){
+    return (n_ap + 63) / 64;
+}
+
+/* class for the label of an edge-state, a conjunction of literals of the atomic propositions: the i-th proposition
+ * occurs in the label iff the i-th bit of care_ is set, and then it occurs positively iff the i-th bit of
+ * value_ is set (the bits of value_ outside care_ are 0) */
+class EdgeLabel {
+public:
+    std::vector<uint64_t> care_;
+    std::vector<uint64_t> value_;
+public:
+    /* label true over n_ap atomic propositions */
+    explicit EdgeLabel(const size_t n_ap = 0): care_(label_words(n_ap), 0), value_(label_words(n_ap), 0) {}
+
+    /* literal of the i-th atomic proposition */
+    size_t get(const size_t i) const {
+        return get(care_.data(), value_.data(), i);
+    }
+
+    /* set the literal of the i-th atomic proposition */
+    void set(const size_t i, const size_t literal){
+        if (i / 64 >= care_.size()){
+            care_.resize(i / 64 + 1, 0);
+            value_.resize(i / 64 + 1, 0);
+        }
+        set(care_.data(), value_.data(), i, literal);
+    }
+
+    /* literal of the i-th atomic proposition in the masks care and value */
+    static size_t get(const uint64_t* care, const uint64_t* value, const size_t i){
+        const uint64_t bit = uint64_t(1) << (i % 64);
+        if ((care[i / 64] & bit) == 0){
+            return ANY;
+        }
+        return (value[i / 64] & bit) ? POS : NEG;
+    }
+
+    /* set the literal of the i-th atomic proposition in the masks care and value */
+    static void set(uint64_t* care, uint64_t* value, const size_t i, const size_t literal){
+        const uint64_t bit = uint64_t(1) << (i % 64);
+        care[i / 64] = (literal == ANY) ? care[i / 64] & ~bit : care[i / 64] | bit;
+        value[i / 64] = (literal == POS) ? value[i / 64] | bit : value[i / 64] & ~bit;
+    }
+}; /* close class definition */
+
+/* class for the labels of the edge-states of a hoa game (indexed by dense ids): the masks of all labels are
+ * stored in two contiguous arrays of words_ words per vertex, the vertices without labels have label true */
+class EdgeLabels {
+public:
+    /* number of vertices (0 if the game has no labels) */
+    size_t n_vert_;
+    /* number of words of a mask */
+    size_t words_;
+    /* masks of the labels (the masks of v are the words words_*v,...,words_*(v+1)-1) */
+    std::vector<uint64_t> care_;
+    std::vector<uint64_t> value_;
+public:
+    /* no labels */
+    EdgeLabels(): n_vert_(0), words_(0) {}
+
+    /* labels true of n_vert vertices over n_ap atomic propositions */
+    EdgeLabels(const size_t n_vert, const size_t n_ap):
+        n_vert_(n_vert), words_(label_words(n_ap)), care_(words_ * n_vert, 0), value_(words_ * n_vert, 0) {}
+
+    /* if there are no labels (the game is not a hoa game) */
+    bool empty() const {
+        return n_vert_ == 0;
+    }
+
+    /* literal of the i-th atomic proposition in the label of v */
+    size_t get(const size_t v, const size_t i) const {
+        return EdgeLabel::get(care_.data() + words_ * v, value_.data() + words_ * v, i);
+    }
+
+    /* set the label of v */
+    void set(const size_t v, const EdgeLabel& label){
+        std::fill(care_.begin() + words_ * v, care_.begin() + words_ * (v+1), 0);
+        std::fill(value_.begin() + words_ * v, value_.begin() + words_ * (v+1), 0);
+        std::copy_n(label.care_.begin(), std::min(words_, label.care_.size()), care_.begin() + words_ * v);
+        std::copy_n(label.value_.begin(), std::min(words_, label.value_.size()), value_.begin() + words_ * v);
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
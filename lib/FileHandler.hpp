@@ -9,10 +9,18 @@
 #include <set>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <cstring>
 #include <cstdlib>
 #include <chrono>
 #include <functional>
+#include <exception>
+#include <limits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "MultiGame.hpp"
 #include "hoa_consumer_build_parity_game.hh"
@@ -55,35 +63,472 @@ void create(const std::string& filename) {
 }
 
 
+///////////////////////////////////////////////////////////////
+/// Reading games from streams
+///////////////////////////////////////////////////////////////
+
+/* class for the text of a game in an input stream, read in blocks: the lines before the header line (with
+ * first token "parity" for pgsolver format or "HOA:" for hoa format) are skipped, and the text ends with the
+ * last line of the game (an empty line for pgsolver format, or a line containing END for hoa format), so
+ * that the game is parsed in one pass over the input without keeping all of it in memory */
+class GameSource : public std::streambuf {
+public:
+    /* format of the game */
+    enum Format {UNKNOWN, PG, HOA};
+    Format format_;
+private:
+    /* input stream */
+    std::istream* in_;
+    /* current block of the text */
+    std::vector<char> block_;
+    /* the last line of the block so far (only for hoa format) and its length */
+    std::string line_;
+    size_t line_length_;
+    /* if the last line of the game is read */
+    bool done_;
+public:
+    explicit GameSource(std::istream& in): format_(UNKNOWN), in_(&in), line_length_(0), done_(false) {
+        std::string line;
+        while (std::getline(*in_, line)){
+            std::stringstream line_stream(line);
+            std::string name;
+            line_stream >> name;
+            if (name == "parity" || name == "HOA:"){
+                format_ = (name == "parity") ? PG : HOA;
+                break;
+            }
+        }
+        if (format_ == UNKNOWN){ /* there is no game */
+            done_ = true;
+            return;
+        }
+        /* the header line is the first block */
+        block_.assign(line.begin(), line.end());
+        block_.push_back('\n');
+        setg(block_.data(), block_.data(), block_.data() + block_.size());
+    }
+
+protected:
+    /* read the next block of the text */
+    int_type underflow() override {
+        if (gptr() < egptr()){
+            return traits_type::to_int_type(*gptr());
+        }
+        if (done_){
+            return traits_type::eof();
+        }
+        block_.resize(1 << 16);
+        size_t n = in_->rdbuf()->sgetn(block_.data(), block_.size());
+        if (n == 0){
+            done_ = true;
+            return traits_type::eof();
+        }
+        /* cut the block after the last line of the game */
+        for (size_t first = 0; first < n;){
+            const char* end = static_cast<const char*>(std::memchr(block_.data() + first, '\n', n - first));
+            size_t last = end ? end - block_.data() : n;
+            line_length_ += last - first;
+            if (format_ == HOA){
+                line_.append(block_.data() + first, last - first);
+            }
+            if (end){
+                if ((format_ == PG && line_length_ == 0) || (format_ == HOA && line_.find("END") != std::string::npos)){
+                    n = last;
+                    done_ = true;
+                    break;
+                }
+                line_.clear();
+                line_length_ = 0;
+            }
+            first = last + 1;
+        }
+        if (n == 0){
+            return traits_type::eof();
+        }
+        setg(block_.data(), block_.data(), block_.data() + n);
+        return traits_type::to_int_type(*gptr());
+    }
+};
+
+///////////////////////////////////////////////////////////////
+/// Parsing games in pgsolver format
+///////////////////////////////////////////////////////////////
+
+/* class for the lines "vertex colors owner successors" of a game in (generalized) pgsolver format, where
+ * colors and successors are lists of numbers separated by commas and the rest of a line is ignored; the
+ * characters of a line are scanned by hand (without streams), and the lines are stored in flat arrays */
+class PgLines {
+public:
+    /* vertex (original id) and owner of every line */
+    std::vector<size_t> vertex_;
+    std::vector<size_t> owner_;
+    /* colors of the k-th line are colors_[color_begin_[k]],...,colors_[color_begin_[k+1]-1] */
+    std::vector<size_t> color_begin_;
+    std::vector<uint32_t> colors_;
+    /* successors (original ids) of the k-th line are succ_[succ_begin_[k]],...,succ_[succ_begin_[k+1]-1] */
+    std::vector<size_t> succ_begin_;
+    std::vector<size_t> succ_;
+    /* if a line without a vertex (the end of the game) is found */
+    bool stopped_;
+public:
+    PgLines(): color_begin_(1, 0), succ_begin_(1, 0), stopped_(false) {}
+
+    /* number of lines */
+    size_t size() const {
+        return vertex_.size();
+    }
+
+    /* number of colors of the k-th line */
+    size_t n_colors(const size_t k) const {
+        return color_begin_[k+1] - color_begin_[k];
+    }
+
+    /* add the lines of the text [first,last) up to the first line without a vertex */
+    void parse(const char* first, const char* last){
+        while (first < last){
+            const char* end = static_cast<const char*>(std::memchr(first, '\n', last - first));
+            if (!end){
+                end = last;
+            }
+            if (!add_line(first, end)){
+                stopped_ = true;
+                return;
+            }
+            first = end + 1;
+        }
+    }
+
+    /* add the line [first,last); returns false (and adds nothing) if it does not start with a vertex */
+    bool add_line(const char* first, const char* last){
+        size_t vertex;
+        skip_space(first, last);
+        if (!scan_number(first, last, vertex)){
+            return false;
+        }
+        skip_token(first, last);
+        vertex_.push_back(vertex);
+        /* second token is the colors of the vertex */
+        skip_space(first, last);
+        for (size_t col; scan_number(first, last, col);){
+            if (col > std::numeric_limits<uint32_t>::max()){
+                throw std::runtime_error("[ERROR] gpg2multigame: colors larger than 2^32-1 are not supported.");
+            }
+            colors_.push_back(col);
+            if (!scan_comma(first, last)){
+                break;
+            }
+        }
+        skip_token(first, last);
+        color_begin_.push_back(colors_.size());
+        /* third token is the owner of the vertex */
+        size_t owner = 0;
+        skip_space(first, last);
+        scan_number(first, last, owner);
+        skip_token(first, last);
+        owner_.push_back(owner);
+        /* fourth token is the successors of the vertex */
+        skip_space(first, last);
+        for (size_t succ; scan_number(first, last, succ);){
+            succ_.push_back(succ);
+            if (!scan_comma(first, last)){
+                break;
+            }
+        }
+        succ_begin_.push_back(succ_.size());
+        return true;
+    }
+
+private:
+    static bool is_space(const char c){
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    static void skip_space(const char*& p, const char* last){
+        while (p < last && is_space(*p)){
+            p++;
+        }
+    }
+
+    /* skip the rest of the current token */
+    static void skip_token(const char*& p, const char* last){
+        while (p < last && !is_space(*p)){
+            p++;
+        }
+    }
+
+    /* read the decimal number at p (if there is one) */
+    static bool scan_number(const char*& p, const char* last, size_t& n){
+        if (p == last || *p < '0' || *p > '9'){
+            return false;
+        }
+        n = 0;
+        for (; p < last && *p >= '0' && *p <= '9'; p++){
+            n = 10 * n + (*p - '0');
+        }
+        return true;
+    }
+
+    /* read the comma at p if a number follows it */
+    static bool scan_comma(const char*& p, const char* last){
+        if (p + 1 < last && *p == ',' && p[1] >= '0' && p[1] <= '9'){
+            p++;
+            return true;
+        }
+        return false;
+    }
+};
+
+/*! construct the graph of the lines of all parts (in order): the declared vertices get the owner of their
+ * last line, and the edges of all lines are added
+ * \param[in] parts     lines of the game
+ * \param[out] line_of  the last line of every (dense) vertex, as a pair (part, index of the line) */
+mpa::Graph pglines2graph(const std::vector<PgLines>& parts, std::vector<std::pair<size_t, size_t>>& line_of){
+    mpa::Graph graph;
+    size_t n_lines = 0;
+    size_t max_id = 0;
+    for (const auto& part : parts){
+        n_lines += part.size();
+        for (auto id : part.vertex_){
+            max_id = std::max(max_id, id);
+        }
+    }
+    /* last line of every original id */
+    std::vector<std::pair<size_t, size_t>> last_line(n_lines == 0 ? 0 : max_id+1, std::make_pair(mpa::Graph::npos, 0));
+    for (size_t p = 0; p < parts.size(); p++){
+        for (size_t k = 0; k < parts[p].size(); k++){
+            last_line[parts[p].vertex_[k]] = std::make_pair(p, k);
+        }
+    }
+    /* renumber the vertices in the order of their original ids */
+    graph.index_.assign(last_line.size(), mpa::Graph::npos);
+    line_of.clear();
+    for (size_t id = 0; id < last_line.size(); id++){
+        if (last_line[id].first != mpa::Graph::npos){
+            graph.index_[id] = graph.ids_.size();
+            graph.ids_.push_back(id);
+            graph.owner_.push_back(parts[last_line[id].first].owner_[last_line[id].second]);
+            line_of.push_back(last_line[id]);
+        }
+    }
+    graph.n_vert_ = graph.ids_.size();
+
+    /* count the successors of every vertex, and the position of the successors of every line in its row */
+    graph.succ_begin_.assign(graph.n_vert_+1, 0);
+    std::vector<std::vector<size_t>> line_pos(parts.size());
+    for (size_t p = 0; p < parts.size(); p++){
+        line_pos[p].resize(parts[p].size());
+        for (size_t k = 0; k < parts[p].size(); k++){
+            size_t v = graph.index_[parts[p].vertex_[k]];
+            line_pos[p][k] = graph.succ_begin_[v+1];
+            graph.succ_begin_[v+1] += parts[p].succ_begin_[k+1] - parts[p].succ_begin_[k];
+        }
+    }
+    for (size_t v = 0; v < graph.n_vert_; v++){
+        graph.succ_begin_[v+1] += graph.succ_begin_[v];
+    }
+    /* place the successors of all lines in their rows (the first undeclared successor of every part is kept) */
+    graph.succ_.resize(graph.succ_begin_[graph.n_vert_]);
+    std::vector<std::pair<size_t, size_t>> undeclared(parts.size(), std::make_pair(mpa::Graph::npos, 0));
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t p = 0; p < parts.size(); p++){
+        const PgLines& part = parts[p];
+        for (size_t k = 0; k < part.size() && undeclared[p].first == mpa::Graph::npos; k++){
+            size_t pos = graph.succ_begin_[graph.index_[part.vertex_[k]]] + line_pos[p][k];
+            for (size_t i = part.succ_begin_[k]; i < part.succ_begin_[k+1]; i++){
+                size_t u = graph.dense_id(part.succ_[i]);
+                if (u == mpa::Graph::npos){
+                    undeclared[p] = std::make_pair(part.vertex_[k], part.succ_[i]);
+                    break;
+                }
+                graph.succ_[pos++] = u;
+            }
+        }
+    }
+    for (const auto& edge : undeclared){
+        if (edge.first != mpa::Graph::npos){
+            throw std::runtime_error("Error: edge (" + std::to_string(edge.first) + ", " + std::to_string(edge.second) + ") uses an undeclared vertex.");
+        }
+    }
+    graph.finish_rows();
+    return graph;
+}
+
+/*! construct the game of the lines of all parts (the first color of a line is the color of its vertex)
+ * \param[in] parts  lines of the game */
+mpa::Game pglines2game(const std::vector<PgLines>& parts){
+    mpa::Game G;
+    std::vector<std::pair<size_t, size_t>> line_of;
+    G.set_graph(pglines2graph(parts, line_of));
+    /* the initial vertex is the vertex with original id 0 (none if there is no such vertex) */
+    G.init_vert_ = G.graph_.dense_id(0);
+    G.max_color_ = 0;
+    for (const auto& part : parts){
+        for (size_t k = 0; k < part.size(); k++){
+            if (part.n_colors(k) > 0){
+                G.max_color_ = std::max<size_t>(G.max_color_, part.colors_[part.color_begin_[k]]);
+            }
+        }
+    }
+    G.colors_.assign(G.graph_.n_vert_, 0);
+    for (size_t v = 0; v < G.graph_.n_vert_; v++){
+        const PgLines& part = parts[line_of[v].first];
+        if (part.n_colors(line_of[v].second) > 0){
+            G.colors_[v] = part.colors_[part.color_begin_[line_of[v].second]];
+        }
+    }
+    return G;
+}
+
+/*! construct the dist-game of the lines of all parts (the i-th color of a line is the color of its vertex
+ * in the i-th game, and the vertices with less colors have color 0 in the other games)
+ * \param[in] parts  lines of the game */
+mpa::MultiGame pglines2multigame(const std::vector<PgLines>& parts){
+    mpa::MultiGame G;
+    std::vector<std::pair<size_t, size_t>> line_of;
+    G.set_graph(pglines2graph(parts, line_of));
+    /* the initial vertex is the vertex with original id 0 (none if there is no such vertex) */
+    G.init_vert_ = G.graph_.dense_id(0);
+    /* number of games and maximum color of every game (over all lines) */
+    size_t n_games = 0;
+    for (const auto& part : parts){
+        for (size_t k = 0; k < part.size(); k++){
+            n_games = std::max(n_games, part.n_colors(k));
+        }
+    }
+    std::vector<size_t> max_color(n_games, 0);
+    for (const auto& part : parts){
+        for (size_t k = 0; k < part.size(); k++){
+            for (size_t i = 0; i < part.n_colors(k); i++){
+                max_color[i] = std::max<size_t>(max_color[i], part.colors_[part.color_begin_[k] + i]);
+            }
+        }
+    }
+    G.all_max_color_.resize(G.all_max_color_.size() + n_games, 0);
+    std::copy(max_color.begin(), max_color.end(), G.all_max_color_.begin());
+    G.all_colors_ = mpa::ColorMatrix(G.graph_.n_vert_);
+    for (size_t i = 0; i < n_games; i++){
+        G.all_colors_.add_column(0, max_color[i]);
+    }
+    /* the columns are wide enough for all colors, so that they are set in parallel */
+    #pragma omp parallel for schedule(static)
+    for (size_t v = 0; v < G.graph_.n_vert_; v++){
+        const PgLines& part = parts[line_of[v].first];
+        size_t k = line_of[v].second;
+        for (size_t i = 0; i < part.n_colors(k); i++){
+            G.all_colors_.set(i, v, part.colors_[part.color_begin_[k] + i]);
+        }
+    }
+    G.n_games_ = G.all_colors_.size();
+    return G;
+}
+
+/* number of threads for parsing games */
+size_t parse_threads(){
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/* class for a file mapped into memory (read only) */
+class MappedFile {
+public:
+    /* text of the file */
+    const char* data_;
+    size_t size_;
+private:
+    int fd_;
+public:
+    explicit MappedFile(const std::string& filename): data_(nullptr), size_(0), fd_(-1) {
+        fd_ = open(filename.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd_ < 0 || fstat(fd_, &st) != 0){
+            if (fd_ >= 0){
+                close(fd_);
+            }
+            throw std::runtime_error("[ERROR] cannot open the file " + filename + ".");
+        }
+        size_ = st.st_size;
+        if (size_ == 0){
+            return;
+        }
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (data == MAP_FAILED){
+            close(fd_);
+            throw std::runtime_error("[ERROR] cannot map the file " + filename + " into memory.");
+        }
+        madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile(){
+        if (data_){
+            munmap(const_cast<char*>(data_), size_);
+        }
+        close(fd_);
+    }
+};
+
+
 ///////////////////////////////////////////////////////////////
 /// Read games from different formats
 ///////////////////////////////////////////////////////////////
 
+/*! copy the data collected by the hoa consumer to a game (everything is moved to dense ids)
+ * \param[in] data  parsed parity game data
+ * \param[in] G     game to be filled */
+void data2game(const cpphoafparser::parity_game_data& data, mpa::Game& G){
+    mpa::GraphBuilder builder;
+    for (auto v : data.vertices){
+        if (data.vert_id.find(v) == data.vert_id.end()){
+            throw std::runtime_error("Error: owner of state " + std::to_string(v) + " is not given (spot-state-player).");
+        }
+        builder.add_vertex(v, data.vert_id.at(v));
+    }
+    for (const auto& pair : data.edges){
+        for (auto u : pair.second){
+            builder.add_edge(pair.first, u);
+        }
+    }
+    G.set_graph(builder.build());
+    const mpa::Graph& graph = G.graph_;
+
+    G.max_color_ = data.max_color;
+    G.colors_.assign(graph.n_vert_, data.minCol);
+    for (const auto& pair : data.colors){
+        G.colors_[graph.dense_id(pair.first)] = pair.second;
+    }
+    G.init_vert_ = graph.dense_id(data.init_vert);
+    G.ap_id_ = data.ap_id;
+    if (!data.labels.empty()){
+        G.labels_ = mpa::EdgeLabels(graph.n_vert_, data.ap_id.size());
+    }
+    for (const auto& pair : data.labels){
+        G.labels_.set(graph.dense_id(pair.first), pair.second);
+    }
+    G.controllable_ap_ = data.controllable_ap;
+    for (const auto& pair : data.state_names){
+        G.state_names_[graph.dense_id(pair.first)] = pair.second;
+    }
+    G.min_col_ = data.minCol;
+}
+
 /*! read a game in extended hoa format from a file/input and convert it to normal game
  * \param[in] filename  Name of the file OR
- * \param[in] issr input stream */
-mpa::Game hoa2game(std::istream& issr){
+ * \param[in] issr input stream
+ * \param[in] check_validity  if the validity of the game is checked (false for trusted inputs, whose tokens
+ *                            are passed straight to the consumer building the game) */
+mpa::Game hoa2game(std::istream& issr, const bool check_validity = true){
     mpa::Game G;
     cpphoafparser::HOAConsumer::ptr consumer;
     cpphoafparser::parity_game_data data;
     consumer.reset(new cpphoafparser::HOAConsumerBuildParityGame(&data));
-    cpphoafparser::HOAParser::parse(issr, consumer);
-
-    G.n_vert_ = data.n_vert;
-    G.n_edge_ = data.n_edge;
-    G.vertices_ = data.vertices;
-    G.edges_ = data.edges;
-    G.vert_id_ = data.vert_id;
-    G.max_color_ = data.max_color;
-    G.colors_ = data.colors;
-    G.pre_edges_ = data.pre_edges;
-    G.init_vert_ = data.init_vert;
-    G.ap_id_ = data.ap_id;
-    G.labels_ = data.labels;
-    G.controllable_ap_ = data.controllable_ap;
-    G.state_names_ = data.state_names;
-    G.min_col_ = data.minCol;
+    cpphoafparser::HOAParser::parse(issr, consumer, check_validity);
 
+    data2game(data, G);
     return G;
 }
 mpa::Game hoa2game(const std::string filename){
@@ -96,7 +541,6 @@ mpa::Game hoa2game(const std::string filename){
  * \param[in] filename  Name of the file OR
  * \param[in] issr input stream */
 mpa::Game pg2game(std::istream& issr){
-    mpa::Game G;
     std::string line;
     /* go through all the lines until a match with arr_name is found */
     while(std::getline(issr,line)) {
@@ -108,46 +552,10 @@ mpa::Game pg2game(std::istream& issr){
             break; /* break the loop when header line found */
         }
     }
-    /* initialize everything to be 0 */
-    G.n_vert_ = 0;
-    G.n_edge_ = 0;
-    G.init_vert_ = 0;
-    G.max_color_ = 0;
-    while(std::getline(issr,line)) {
-        std::stringstream line_stream(line);
-        G.n_vert_ += 1;
-        /* first number is (index of) the vertex */
-        size_t vertex;
-        line_stream >> vertex;
-        G.vertices_.insert(vertex);
-
-        /* second number is colors of that vertex */
-        size_t color; 
-        line_stream >> color;
-        G.colors_[vertex] = color;
-        /* update the max_color */
-        if (G.max_color_ < color){
-            G.max_color_ = color;
-        }
-        
-        /* third number is owner of that vertex */
-        size_t vert_id;
-        line_stream >> vert_id;
-        /* set the owner of that vertex */
-        G.vert_id_[vertex] = vert_id;
-        
-        std::string successors; /* string of successors of that vertex */
-        line_stream >> successors;
-        std::stringstream ss(successors);
-        /* update transitions of that vertex */
-        for (size_t i; ss >> i; ++ i) {
-            G.edges_[vertex].insert(i);
-            G.n_edge_ += 1;
-            if (ss.peek() == ',')
-                ss.ignore();
-        }
-    }
-    return G;
+    /* the lines of the game up to the first line without a vertex */
+    std::vector<PgLines> parts(1);
+    while(std::getline(issr,line) && parts[0].add_line(line.data(), line.data() + line.size())) {}
+    return pglines2game(parts);
 }
 mpa::Game pg2game(const std::string& filename){
     std::ifstream file(filename);
@@ -169,42 +577,15 @@ mpa::Game file2game(const std::string& filename){
     }
 }
 
-/* read a game from std::cin */
-mpa::Game std2game(){
-    size_t pg = 2; /* determine if the format is psolver (default: 2 = undecided) */
-    /* construct the game from stdin */
-    std::string str, line;
-    while (std::getline(std::cin, line)){
-        if (pg == 2){
-            std::stringstream line_stream(line);
-            std::string name;
-            line_stream >> name;
-            /* check for the header line starting with "parity" then it is pgsolver format */
-            if (name == "parity"){
-                pg = 1;
-                str += "\n" + line;
-            }
-            /* check for the header line starting with "HOA:" then it is hoa format */
-            else if (name == "HOA:"){
-                pg = 0;
-                str += "\n" + line;
-            }
-        }
-        else{
-            str += "\n" + line;
-            if (pg == 0 && line.find("END") != std::string::npos){
-                break;
-            }
-            else if (pg == 1 && line == ""){
-                break;
-            }
-        }
-    }
-    std::istringstream issr(str);
-    if (pg == 1){
+/* read a game from std::cin (check_validity as for hoa2game) */
+mpa::Game std2game(const bool check_validity = true){
+    /* construct the game from stdin (the format is given by the header line) */
+    GameSource source(std::cin);
+    std::istream issr(&source);
+    if (source.format_ == GameSource::PG){
         return pg2game(issr);
     }
-    return hoa2game(issr);
+    return hoa2game(issr, check_validity);
 }
 
 
@@ -217,8 +598,6 @@ mpa::Game std2game(){
  * \param[in] filename  Name of the file OR
  * \param[in] issr input stream */
 mpa::MultiGame gpg2multigame(std::istream& issr){
-    mpa::MultiGame G;
-    G.all_colors_.clear();
     std::string line;
     /* go through all the lines until a match with arr_name is found */
     while(std::getline(issr,line)) {
@@ -230,101 +609,63 @@ mpa::MultiGame gpg2multigame(std::istream& issr){
             break; /* break the loop when header line found */
         }
     }
-    /* initialize everything */
-    G.n_vert_ = 0;
-    G.n_edge_ = 0;
-    G.init_vert_ = 0;
-    while(std::getline(issr,line)) {
-        std::stringstream line_stream(line);
-        G.n_vert_ += 1;
-        /* first number is (index of) the vertex */
-        size_t vertex;
-        line_stream >> vertex;
-        G.vertices_.insert(vertex);
-        /* second string is colors of that vertex */
-        std::string colors; /* string of colors of that vertex */
-        line_stream >> colors;
-        std::stringstream ss_col(colors);
-        /* add the colors of that vertex */
-        size_t counter_games = 0;
-        for (size_t col; ss_col >> col; ++ col){
-            if (counter_games == G.all_colors_.size()){
-                G.all_colors_.push_back(std::map<size_t, size_t>());
-                G.all_max_color_.push_back(0);
-            }
-            G.all_colors_[counter_games][vertex] = col;
-            /* update the max_colors */
-            if (G.all_max_color_[counter_games] < col){
-                G.all_max_color_[counter_games] = col;
-            }
-            if (ss_col.peek() == ',')
-                ss_col.ignore();
-            counter_games += 1;
-        }
-        
-        /* third number is owner of that vertex */
-        size_t vert_id;
-        line_stream >> vert_id;
-        /* set the owner of that vertex */
-        G.vert_id_[vertex] = vert_id;
-        
-        std::string successors; /* string of successors of that vertex */
-        line_stream >> successors;
-        std::stringstream ss(successors);
-        /* update transitions of that vertex */
-        for (size_t i; ss >> i; ++ i) {
-            G.edges_[vertex].insert(i);
-            G.n_edge_ += 1;
-            if (ss.peek() == ',')
-                ss.ignore();
-        }
-    }
-    G.n_games_ = G.all_colors_.size();
-    return G;
+    /* the lines of the game up to the first line without a vertex */
+    std::vector<PgLines> parts(1);
+    while(std::getline(issr,line) && parts[0].add_line(line.data(), line.data() + line.size())) {}
+    return pglines2multigame(parts);
 }
 mpa::MultiGame gpg2multigame(const std::string& filename){
     std::ifstream file(filename);
     return gpg2multigame(file);
 }
 
-/*! read a game in extended hoa format from a file/input and convert it to dist game
+/*! copy the data collected by the hoa consumer to a dist-game
+ * \param[in] data  parsed parity game data
+ * \param[in] G     dist-game to be filled */
+void data2multigame(const cpphoafparser::parity_game_data& data, mpa::MultiGame& G){
+    data2game(data, G);
+
+    /* vertices without colors in the i-th game get the minimum color */
+    G.n_games_ = data.all_colors.size();
+    G.all_colors_ = mpa::ColorMatrix(G.graph_.n_vert_);
+    for (size_t i = 0; i < G.n_games_; i++){
+        G.all_colors_.add_column(data.minCol);
+        for (const auto& pair : data.all_colors[i]){
+            G.all_colors_.set(i, G.graph_.dense_id(pair.first), pair.second);
+        }
+    }
+    for (size_t i = 0; i < G.n_games_; i++){
+        G.all_max_color_.push_back(G.max_col(G.all_colors_.column(i)));
+    }       
+}
+
+/*! read a game in extended hoa format from a file/input/memory and convert it to dist game
  * \param[in] filename  Name of the file OR
- * \param[in] issr input stream */
-mpa::MultiGame hoa2multigame(std::istream& issr){
+ * \param[in] issr input stream OR
+ * \param[in] data, size  the characters of the game
+ * \param[in] check_validity  as for hoa2game */
+mpa::MultiGame hoa2multigame(std::istream& issr, const bool check_validity = true){
     mpa::MultiGame G;
     cpphoafparser::HOAConsumer::ptr consumer;
     cpphoafparser::parity_game_data data;
     consumer.reset(new cpphoafparser::HOAConsumerBuildParityGame(&data));
-    cpphoafparser::HOAParser::parse(issr, consumer);
-
-    G.n_vert_ = data.n_vert;
-    G.n_edge_ = data.n_edge;
-    G.vertices_ = data.vertices;
-    G.edges_ = data.edges;
-    G.pre_edges_ = data.pre_edges;
-    G.init_vert_ = data.init_vert;
-    G.ap_id_ = data.ap_id;
-    G.labels_ = data.labels;
-    G.controllable_ap_ = data.controllable_ap;
-    G.vert_id_ = data.vert_id;
-    G.max_color_ = data.max_color;
-    G.colors_ = data.colors;
-    G.state_names_ = data.state_names;
-    G.min_col_ = data.minCol;
+    cpphoafparser::HOAParser::parse(issr, consumer, check_validity);
 
-    
-    G.n_games_ = data.all_colors.size();
-    for (auto v : G.vertices_){
-        for (size_t i = 0; i < G.n_games_; i++){
-            if (data.all_colors[i].find(v) == data.all_colors[i].end()){
-                data.all_colors[i][v] = data.minCol;
-            }
-        }
+    data2multigame(data, G);
+    return G;
+}
+mpa::MultiGame hoa2multigame(const char* data, const size_t size, const bool check_validity = true){
+    mpa::MultiGame G;
+    cpphoafparser::parity_game_data game_data;
+    /* the states of a trusted input are parsed in parallel (at least 4 blocks per thread) */
+    if (check_validity || !cpphoafparser::parse_parity_game_blocks(data, size, 4 * parse_threads(), game_data)){
+        game_data = cpphoafparser::parity_game_data();
+        cpphoafparser::HOAConsumer::ptr consumer;
+        consumer.reset(new cpphoafparser::HOAConsumerBuildParityGame(&game_data));
+        cpphoafparser::HOAParser::parse(data, size, consumer, check_validity);
     }
-    G.all_colors_ = data.all_colors;
-    for (size_t i = 0; i < G.n_games_; i++){
-        G.all_max_color_.push_back(G.max_col(G.all_colors_[i]));
-    }       
+
+    data2multigame(game_data, G);
     return G;
 }
 mpa::Game hoa2multigame(const std::string& filename){
@@ -332,43 +673,77 @@ mpa::Game hoa2multigame(const std::string& filename){
     return hoa2multigame(file);
 }
 
-/* read a dist-game from std::cin */
-mpa::MultiGame std2multigame(){
-    size_t pg = 2; /* determine if the format is psolver (default: 2 = undecided) */
-    /* construct the game from stdin */
-    std::string str, line;
-    while (std::getline(std::cin, line)){
-        if (pg == 2){
-            std::stringstream line_stream(line);
-            std::string name;
-            line_stream >> name;
-            /* check for the header line starting with "parity" then it is pgsolver format */
-            if (name == "parity"){
-                pg = 1;
-                str += "\n" + line;
-            }
-            /* check for the header line starting with "HOA:" then it is hoa format */
-            else if (name == "HOA:"){
-                pg = 0;
-                str += "\n" + line;
-            }
+/* read a dist-game from std::cin (check_validity as for hoa2game) */
+mpa::MultiGame std2multigame(const bool check_validity = true){
+    /* construct the game from stdin (the format is given by the header line) */
+    GameSource source(std::cin);
+    std::istream issr(&source);
+    if (source.format_ == GameSource::PG){
+        return gpg2multigame(issr);
+    }
+
+    return hoa2multigame(issr, check_validity);
+}
+
+/*! read a dist-game from a file mapped into memory: the lines of a game in (generalized) pgsolver format
+ * are split into chunks of whole lines which are parsed in parallel, and a game in hoa format is lexed in
+ * place (with its State: definitions parsed in parallel if check_validity is false); the format is given by
+ * the header line
+ * \param[in] filename  Name of the file
+ * \param[in] check_validity  as for hoa2game */
+mpa::MultiGame mapped2multigame(const std::string& filename, const bool check_validity = true){
+    MappedFile file(filename);
+    const char* first = file.data_;
+    const char* last = file.data_ + file.size_;
+    /* skip the lines up to the header line */
+    GameSource::Format format = GameSource::UNKNOWN;
+    const char* header = last;
+    while (first < last && format == GameSource::UNKNOWN){
+        const char* end = static_cast<const char*>(std::memchr(first, '\n', last - first));
+        end = end ? end : last;
+        std::string name;
+        std::stringstream(std::string(first, end)) >> name;
+        if (name == "parity" || name == "HOA:"){
+            format = (name == "parity") ? GameSource::PG : GameSource::HOA;
+            header = first;
         }
-        else{
-            str += "\n" + line;
-            if (pg == 0 && line.find("END") != std::string::npos){
-                break;
-            }
-            else if (pg == 1 && line == ""){
-                break;
-            }
+        first = std::min(end + 1, last);
+    }
+    if (format != GameSource::PG){
+        return hoa2multigame(header, last - header, check_validity);
+    }
+    /* chunks of about 1MB (at least 4 per thread) that start at the beginning of a line */
+    size_t n_chunks = std::max<size_t>((last - first) >> 20, 4 * parse_threads());
+    n_chunks = std::max<size_t>(1, std::min<size_t>(n_chunks, last - first));
+    std::vector<const char*> bounds(n_chunks+1, last);
+    bounds[0] = first;
+    for (size_t c = 1; c < n_chunks; c++){
+        const char* start = std::max(bounds[c-1], first + (last - first) / n_chunks * c);
+        const char* end = static_cast<const char*>(std::memchr(start - 1, '\n', last - start + 1));
+        bounds[c] = end ? end + 1 : last;
+    }
+    std::vector<PgLines> parts(n_chunks);
+    std::vector<std::exception_ptr> errors(n_chunks);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t c = 0; c < n_chunks; c++){
+        try {
+            parts[c].parse(bounds[c], bounds[c+1]);
+        }
+        catch (...){
+            errors[c] = std::current_exception();
         }
     }
-    std::istringstream issr(str);
-    if (pg == 1){
-        return gpg2multigame(issr);
+    /* the game ends with the first line without a vertex */
+    for (size_t c = 0; c < n_chunks; c++){
+        if (errors[c]){
+            std::rethrow_exception(errors[c]);
+        }
+        if (parts[c].stopped_){
+            parts.resize(c+1);
+            break;
+        }
     }
-
-    return hoa2multigame(issr);
+    return pglines2multigame(parts);
 }
 
 /*! read a game in pgsolver/ehoa format from a file and convert it to dist game
@@ -416,7 +791,9 @@ int game2hoa(const mpa::Game& G, std::ostream& ostr = std::cout) {
     size_t n_vertices = G.n_vert_ - G.n_edge_/2;
     ostr << "HOA: v1\n";
     ostr << "States: "<< n_vertices << "\n";
-    ostr << "Start: "<< G.init_vert_ << "\n";
+    if (G.init_vert_ != mpa::Graph::npos){ /* a game without initial vertex has no Start: line */
+        ostr << "Start: "<< G.graph_.original_id(G.init_vert_) << "\n";
+    }
     ostr << "AP: "<< G.ap_id_.size();
     for (auto pair : G.ap_id_){
         ostr << " \"" << pair.second << "\"";
@@ -426,7 +803,7 @@ int game2hoa(const mpa::Game& G, std::ostream& ostr = std::cout) {
     ostr << "properties: trans-labels explicit-labels trans-acc deterministic\n";
     ostr << "spot-state-player:";
     for (size_t i = 0; i < n_vertices; i++){
-        ostr << " " << 1-G.vert_id_.at(i);
+        ostr << " " << 1-G.owner(i);
     }
     ostr << "\ncontrollable-AP:";
     for (auto a : G.controllable_ap_){
@@ -435,16 +812,16 @@ int game2hoa(const mpa::Game& G, std::ostream& ostr = std::cout) {
     /* print the body */
     ostr << "\n--BODY--\n";
     for (size_t u = 0; u < n_vertices; u++){
-        if (G.vert_id_.at(u) != 2){
-            ostr << "State: "<< u;
+        if (G.owner(u) != 2){
+            ostr << "State: "<< G.graph_.original_id(u);
             if (!G.state_names_.empty() && G.state_names_.at(u) != ""){
                 ostr << " \""<<G.state_names_.at(u)<<"\"";
             }
             ostr << " {" << G.colors_.at(u)<<"}";
             ostr << "\n";
-            for (auto v : G.edges_.at(u)){
+            for (auto v : G.successors(u)){
                 ostr << "[" << G.print_label(v,true) << "] ";
-                ostr << *G.edges_.at(v).begin();
+                ostr << G.graph_.original_id(G.successors(v)[0]);
                 ostr << " {" << G.colors_.at(v)<<"}";
                 ostr << "\n";
             }
@@ -466,7 +843,9 @@ int multigame2hoa(mpa::MultiGame& G, std::ostream& ostr = std::cout) {
     size_t n_vertices = G.n_vert_ - G.n_edge_/2;
     ostr << "HOA: v1\n";
     ostr << "States: "<< n_vertices << "\n";
-    ostr << "Start: "<< G.init_vert_ << "\n";
+    if (G.init_vert_ != mpa::Graph::npos){ /* a game without initial vertex has no Start: line */
+        ostr << "Start: "<< G.graph_.original_id(G.init_vert_) << "\n";
+    }
     ostr << "AP: "<< G.ap_id_.size();
     for (auto pair : G.ap_id_){
         ostr << " \"" << pair.second << "\"";
@@ -481,7 +860,7 @@ int multigame2hoa(mpa::MultiGame& G, std::ostream& ostr = std::cout) {
     ostr << "properties: trans-labels explicit-labels trans-acc deterministic\n";
     ostr << "spot-state-player:";
     for (size_t i = 0; i < n_vertices; i++){
-        ostr << " " << 1-G.vert_id_.at(i);
+        ostr << " " << 1-G.owner(i);
     }
     ostr << "\ncontrollable-AP:";
     for (auto a : G.controllable_ap_){
@@ -490,27 +869,27 @@ int multigame2hoa(mpa::MultiGame& G, std::ostream& ostr = std::cout) {
     /* print the body */
     ostr << "\n--BODY--\n";
     for (size_t u = 0; u < n_vertices; u++){
-        if (G.vert_id_.at(u) != 2){
-            ostr << "State: "<< u;
+        if (G.owner(u) != 2){
+            ostr << "State: "<< G.graph_.original_id(u);
             if (!G.state_names_.empty() && G.state_names_.at(u) != ""){
                 ostr << " \""<<G.state_names_.at(u)<<"\"";
             }
             ostr << " {";
             // G.all_colors_[0].at(v) << " "<<G.all_colors_[1].at(v);
             for (size_t i = 0; i < G.n_games_; i++){
-                ostr << G.all_colors_[i].at(u);
+                ostr << G.color(i, u);
                 if (i < G.n_games_-1){
                     ostr << " ";
                 }
             }
             ostr << "}\n";
-            for (auto v : G.edges_.at(u)){
+            for (auto v : G.successors(u)){
                 ostr << "[" << G.print_label(v,true) << "] ";
-                ostr << *G.edges_.at(v).begin();
+                ostr << G.graph_.original_id(G.successors(v)[0]);
                 ostr << " {";
                 // G.all_colors_[0].at(v) << " "<<G.all_colors_[1].at(v);
                 for (size_t i = 0; i < G.n_games_; i++){
-                    ostr << G.all_colors_[i].at(v);
+                    ostr << G.color(i, v);
                     if (i < G.n_games_-1){
                         ostr << " ";
                     }
@@ -527,28 +906,28 @@ int multigame2hoa(mpa::MultiGame& G, std::ostream& ostr = std::cout) {
  * \param[in] MultiGame  */
 int multigame2gpg(mpa::MultiGame& G, std::ostream& ostr = std::cout){
     /* print first line */
-    ostr<< "parity "<< G.n_vert_-1 <<";\n"; 
+    ostr<< "parity "<< (G.vertices_.empty() ? 0 : G.graph_.original_id(*G.vertices_.rbegin())) <<";\n"; 
         
-    for (size_t v = 0; v < G.n_vert_; v++){ /* print the following for each vertex */
-        ostr << v << " "; /* vertex name (number) */
-        ostr<<G.all_colors_[0].at(v); /* print color in 1st game separately to avoid comma */
+    for (auto v : G.vertices_){ /* print the following for each vertex */
+        ostr << G.graph_.original_id(v) << " "; /* vertex name (number) */
+        ostr<<G.color(0, v); /* print color in 1st game separately to avoid comma */
         if (G.n_games_ > 1){
             for (size_t i = 1; i < G.n_games_; i++){/* for each other game print color of v with comma */
-                ostr<<","<<G.all_colors_[i].at(v);
+                ostr<<","<<G.color(i, v);
             }
         }
 
-        ostr << " " << G.vert_id_.at(v) << " "; /* print vertex id (which player it belongs to) */
+        ostr << " " << G.owner(v) << " "; /* print vertex id (which player it belongs to) */
         
-        if (!G.edges_.at(v).empty()){ /* if v has neighbours then print them */
+        if (!G.successors(v).empty()){ /* if v has neighbours then print them */
             size_t counter = 0;
-            for (auto u : G.edges_.at(v)){ /* print all neighbours */
+            for (auto u : G.successors(v)){ /* print all neighbours */
                 if (counter == 0){
-                    ostr <<u;
+                    ostr <<G.graph_.original_id(u);
                     counter = 1;
                 }
                 else{
-                    ostr <<","<<u;
+                    ostr <<","<<G.graph_.original_id(u);
                 }
             }
         }
@@ -575,7 +954,7 @@ int multigame2std(mpa::MultiGame& G, std::ostream& ostr = std::cout, const std::
 int game2pg(const mpa::Game& G, std::ostream& ostr = std::cout){
     mpa::MultiGame G1(G);
     G1.n_games_ = 1;
-    G1.all_colors_.push_back(G.colors_);
+    G1.all_colors_.add_column(G.colors_);
     G1.all_max_color_.push_back(G.max_color_);
     return multigame2gpg(G1, ostr);
 }
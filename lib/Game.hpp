@@ -8,9 +8,9 @@
 #define GAME_HPP_
 
 #include "Template.hpp"
-
-#define V0 0 /* vertices belonging to player 0 */
-#define V1 1 /* vertices belonging to player 1 */
+#include "Graph.hpp"
+#include "GameView.hpp"
+#include "EdgeLabel.hpp"
 
 namespace mpa {
 class Game {
@@ -19,26 +19,22 @@ public:
     size_t n_vert_;
     /* number of edges */
     size_t n_edge_;
-    /* vertices */
+    /* vertices (dense ids of the graph) */
     std::set<size_t> vertices_;
-    /* initial vertex */
+    /* initial vertex (Graph::npos if the game has no initial vertex) */
     size_t init_vert_;
-    /* vertex id: V0, when the vertex belongs to player 0 and V1 when it belongs to player 1 */
-    std::map<size_t, size_t> vert_id_;
-    /* edges as a map from vertices to set of its neighbours */
-    std::map<size_t, std::set<size_t>> edges_;
+    /* game graph: successors and owners (V0, when the vertex belongs to player 0 and V1 when it belongs to player 1) */
+    Graph graph_;
     /* maximum of colors */
     size_t max_color_;
-    /* colors of vertices */
-    std::map<size_t, size_t> colors_;
+    /* colors of vertices (indexed by dense ids) */
+    std::vector<size_t> colors_;
 
     /* variables needed for ehoa formatted games */
-    /* pre of edges for original vertices (incoming edges) */
-    std::map<size_t, std::set<size_t>> pre_edges_;
     /* ids of atomic proposition */
     std::map<size_t, std::string> ap_id_;
-    /* labels of mid-state */
-    std::map<size_t, std::vector<size_t>> labels_;
+    /* labels of mid-states (packed (care, value) masks indexed by dense ids) */
+    EdgeLabels labels_;
     /* controllable APs */
     std::set<size_t> controllable_ap_;
     /* name of states */
@@ -50,6 +46,46 @@ public:
     Game() {
         n_vert_ = 0;
         n_edge_ = 0;
+        init_vert_ = Graph::npos;
+    }
+
+    /* set the game graph (all of its vertices are in the game) */
+    void set_graph(Graph graph){
+        graph_ = std::move(graph);
+        n_vert_ = graph_.n_vert_;
+        n_edge_ = graph_.n_edge_;
+        vertices_.clear();
+        for (size_t v = 0; v < n_vert_; v++){
+            vertices_.insert(vertices_.end(), v);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Access to the game graph
+    ///////////////////////////////////////////////////////////////
+
+    /* owner of vertex v */
+    size_t owner(const size_t v) const {
+        return graph_.owner(v);
+    }
+
+    /* successors of vertex v */
+    std::span<const size_t> successors(const size_t v) const {
+        return graph_.successors(v);
+    }
+
+    /* predecessors of vertex v (incoming edges) */
+    std::span<const size_t> predecessors(const size_t v) const {
+        return graph_.predecessors(v);
+    }
+
+    /* original ids of a set of vertices */
+    std::set<size_t> original_ids(const std::set<size_t>& set) const {
+        std::set<size_t> result;
+        for (auto v : set){
+            result.insert(result.end(), graph_.original_id(v));
+        }
+        return result;
     }
 
 
@@ -57,59 +93,34 @@ public:
     /// Solving all types of games
     ///////////////////////////////////////////////////////////////
 
+    /* view of the whole game (sharing the graph and the colors) */
+    GameView view() const {
+        return GameView(graph_, colors_, vertex_set(vertices_), max_color_);
+    }
+
     /* solve reachability game for player i (default is player 0)
      * input: target
-     * output: Reach_i(target) */
+     * output: Reach_i(target)
+     * (with players = {} the vertices from which no player can avoid the target) */
     std::pair<std::set<size_t>, std::set<size_t>> solve_reachability_game(const std::set<size_t>& target,
                                                     const std::set<size_t>& players = {V0}) const {
-        std::set<size_t> losing; /* vertices from which targets might not be reachable */
-        std::set<size_t> winning = target; /* vertices from which targets are currently reachable */
-        while (true)
-        {
-            losing = set_complement(winning); /* complement of vertices from which targets are currently reachable */
-            std::set<size_t> new_winning; /* new vertices from which targets are currently reachable */
-            for (size_t v: losing){ /* new_winning =  cpre_i(winning) */
-                if(players.find(vert_id_.at(v)) != players.end() && check_set_intersection(edges_.at(v),winning))
-                    new_winning.insert(v);
-                else if(check_set_inclusion(edges_.at(v),winning) && edges_.find(v) != edges_.end())
-                    new_winning.insert(v);
-            }
-            if (new_winning.empty()){ /* if there is no new winning vertex then return winning */
-                losing = set_complement(winning);
-                return std::make_pair(winning, losing);
-            }
-            set_merge(winning, new_winning); /* include the new targets in winning */
-        }
+        return to_sets(view().solve_reachability_game(vertex_set(target), players));
     }
 
     /* solve Buechi game 
      * input: target
      * output: winning region for player 0 */
     std::pair<std::set<size_t>, std::set<size_t>> solve_buchi_game(const std::set<size_t>& target) const {
-        Game subgame = *this; /* copy the game */
-        std::set<size_t> non_target = set_complement(target); /* vertices which are not target */
-        /* in the subgame (copy of the game), target vertices has color 2 
-        and non-target vertices have color 1 */
-        for (size_t v: target) 
-            subgame.colors_.at(v) = 2;
-        for (size_t v: non_target)
-            subgame.colors_.at(v) = 1;
-        return subgame.solve_parity_game(); /* solve the 2-color parity game using parity algo */
+        /* nested fixpoint on the game graph (the colors are not used) */
+        return to_sets(view().solve_buchi_game(vertex_set(target)));
     }
 
     /* solve Co-Buechi game 
      * input: target (Eventually Always [target])
      * output: winning region for player 0 */
     std::pair<std::set<size_t>, std::set<size_t>> solve_cobuchi_game(const std::set<size_t>& target) const {
-        Game subgame = *this; /* copy the game */
-        std::set<size_t> non_target = set_complement(target); /* vertices which are not target */
-        /* in the subgame (copy of the game), target vertices has color 2 
-        and non-target vertices have color 1 */
-        for (size_t v: target)
-            subgame.colors_.at(v) = 0;
-        for (size_t v: non_target)
-            subgame.colors_.at(v) = 1;
-        return subgame.solve_parity_game(); /* solve the 2-color parity game using parity algo */
+        /* nested fixpoint on the game graph (the colors are not used) */
+        return to_sets(view().solve_cobuchi_game(vertex_set(target)));
     }
 
 
@@ -117,56 +128,15 @@ public:
      * input: game with colors
      * output: winning region for player 0 */
     std::pair<std::set<size_t>, std::set<size_t>> solve_parity_game() const {
-        Game game_copy(*this); /* copy of the game as we will change it */
-        return game_copy.recursive_zielonka_parity();
+        return recursive_zielonka_parity();
     }
-    /* recursive zielonka's algorithm */
+    /* recursive zielonka's algorithm (on views of the game, without copying it) */
     std::pair<std::set<size_t>, std::set<size_t>> recursive_zielonka_parity() const {
-        if (n_vert_ == 0) /* if current region is empty, nothing to do, return empty */
-            return std::make_pair(vertices_, vertices_);
-        /* vertices with maximum color */
-        std::set<size_t> max_col_vertices = vertex_with_color(max_color_);
-        if (max_color_ % 2 == 1){ /* when max_color_ is odd */
-            /* vertices from which player 1 can force to visit max_col_vertices (odd) */
-            auto regionA = solve_reachability_game(max_col_vertices, {V1});
-            /* complement of regionA */
-            Game gameCA(subgame(regionA.second)); /* game with regionA removed */
-            /* solve the gameCA */
-            auto winCA = gameCA.recursive_zielonka_parity();
-            if (winCA.first.empty()) /* if winning region is empty in gameCA then return everything empty */
-                return std::make_pair(winCA.first, vertices_);
-            else {
-                /* vertices from which player 0 can force to reach winning region of gameCA */
-                auto regionB = solve_reachability_game(winCA.first, {V0});
-                Game gameCB(subgame(regionB.second)); /* game with regionB removed */
-                /* solve gameCB */
-                auto winCB = gameCB.recursive_zielonka_parity();
-                return std::make_pair(set_union(winCB.first, regionB.first), winCB.second); /* winning region is regionB \cup winning region of gameCB */
-            }
-        }
-        else{ /* max_color_ is even */
-            /* vertices from which player 0 can force to visit max_col_vertices (even) */
-            auto regionA = solve_reachability_game(max_col_vertices, {V0});
-            /* complement of regionA */
-            Game gameCA(subgame(regionA.second)); /* game with regionA removed */
-            /* solve the gameCA */
-            auto winCA = gameCA.recursive_zielonka_parity();
-            if (winCA.second.empty()){ /* if losing region is empty */
-                return std::make_pair(vertices_, winCA.second); /* winning region is whole set */
-            }
-            else {
-                /* vertices from which player 1 can force to reach losing region of gameCA */
-                auto regionB = solve_reachability_game(winCA.second, {V1});
-                Game gameCB(subgame(regionB.second)); /* game with regionB removed */
-                /* solve gameCB */
-                auto winCB = gameCB.recursive_zielonka_parity();
-                return std::make_pair(winCB.first, set_union(winCB.second, regionB.first)); /* winning region is winning region of gameCB */
-            }
-        }
+        return to_sets(view().recursive_zielonka_parity());
     }
 
     ///////////////////////////////////////////////////////////////
-    ///Buechi games
+    ///Buechi and co-Buechi games
     ///////////////////////////////////////////////////////////////
     
     /* compute the permissive strategy template for Buechi game */
@@ -174,31 +144,31 @@ public:
         /* initialize the template */
         strat.clear();
 
-        /* first compute the winning region */
-        auto winning_region = solve_buchi_game(target);
+        /* compute the winning region and the live groups inside it */
+        auto winning_region = to_sets(view().solve_buchi_game(vertex_set(target), &strat));
         /* unsafe edges are the player 0's edges from winning region to losing region */
         strat.unsafe_edges_ = edges_between(winning_region.first, winning_region.second);
-        /* copy the subgame restricted to winning region */
-        Game game_copy(subgame(winning_region.first));
-        game_copy.find_live_groups_reach(target, winning_region.first, strat);
+        return winning_region;
+    }
+
+    /* compute the permissive strategy template for co-Buechi game (Eventually Always [target]) */
+    std::pair<std::set<size_t>, std::set<size_t>> find_strategy_template_cobuchi(const std::set<size_t>& target, Template& strat) const {
+        /* initialize the template */
+        strat.clear();
+
+        /* compute the winning region, the colive edges and the live groups */
+        auto winning_region = to_sets(view().solve_cobuchi_game(vertex_set(target), &strat));
+        /* unsafe edges are the player 0's edges from winning region to losing region */
+        strat.unsafe_edges_ = edges_between(winning_region.first, winning_region.second);
+        /* remove unsafe edges from colive edges set */
+        edges_remove_vertices(strat.colive_edges_, winning_region.second);
         return winning_region;
     }
 
     void find_live_groups_reach(const std::set<size_t>& target,
                                 const std::set<size_t>& winning_region,
                                 Template& strat) const {
-        std::set<size_t> curr_target = target;
-        /* keep finding live groups until convergence to the winning region */
-        while (1) {
-            /* vertices from which no player can stop reaching cuurent winning region */
-            auto curr_winning_region = solve_reachability_game(curr_target, {});
-            if (curr_winning_region.first.size() == winning_region.size()) {
-                break;
-            }
-            curr_target = curr_winning_region.first; /* current target is the winnign region of last reachability game */
-            /* add live group containing player0 edges from outiside to winning region; and add their sources to curr_target */
-            strat.live_groups_.push_back(edges_between(curr_winning_region.second, curr_winning_region.first, curr_target));
-        }
+        view().find_live_groups_reach(vertex_set(target), vertex_set(winning_region), strat);
     }
 
 
@@ -216,66 +186,15 @@ public:
         /* unsafe edges are the player 0's edges from winning region to losing region */
         strat.unsafe_edges_ = edges_between(winning_region.first, winning_region.second);
         /* remove unsafe edges from colive edges set */
-        map_remove_vertices(strat.colive_edges_, winning_region.second);
+        edges_remove_vertices(strat.colive_edges_, winning_region.second);
         return winning_region;
     }
 
-    /* compute the set of live groups and colive edges recursively */
+    /* compute the set of live groups and colive edges recursively (on views of the game, without copying it) */
     std::pair<std::set<size_t>, std::set<size_t>> recursive_strategy_template_parity(
                                     Template& strat,
                                     const size_t& u = 0) const {
-        // std::cout << u<<"\n";
-        if (n_vert_ == 0) /* if current region is empty, nothing to do, return empty */
-            return std::make_pair(vertices_, vertices_);
-        /* vertices with maximum color */
-        std::set<size_t> max_col_vertices = vertex_with_color(max_color_);
-        if (max_color_ % 2 == 1){ /* when max_color_ is odd */
-            /* vertices from which player 1 can force to visit max_col_vertices (odd) */
-            auto regionA = solve_reachability_game(max_col_vertices, {V1});
-            /* complement of regionA */
-            Game gameCA(subgame(regionA.second)); /* game with regionA removed */
-            /* solve the gameCA */
-            auto winCA = gameCA.recursive_strategy_template_parity(strat,u+1);
-            if (winCA.first.empty()) /* if winning region is empty in gameCA then return everything empty */
-                return std::make_pair(winCA.first, vertices_);
-            else {
-                /* vertices from which player 0 can force to reach winning region of gameCA */
-                auto regionB = solve_reachability_game(winCA.first, {V0});
-                /* edges from winning region of gameCA to regionB (all are player 0's) are colive */
-                edges_between(winCA.first,set_complement(winCA.first), strat.colive_edges_);
-                /* live groups needed to reach winCA from regionB */
-                find_live_groups_reach(winCA.first,regionB.first,strat);
-
-                Game gameCB(subgame(regionB.second)); /* game with regionB removed */
-                /* solve gameCB */
-                auto winCB = gameCB.recursive_strategy_template_parity(strat,u+1);
-                return std::make_pair(set_union(winCB.first, regionB.first), winCB.second); /* winning region is regionB \cup winning region of gameCB */
-            }
-        }
-        else{ /* max_color_ is even */
-            /* vertices from which player 0 can force to visit max_col_vertices (even) */
-            auto regionA = solve_reachability_game(max_col_vertices, {V0});
-            /* complement of regionA */
-            Game gameCA(subgame(regionA.second)); /* game with regionA removed */
-            /* solve the gameCA with output in new template */
-            Template& stratCA = strat;
-            auto winCA = gameCA.recursive_strategy_template_parity(stratCA,u+1);
-            if (winCA.second.empty()){ /* if losing region is empty */
-                /* output template gameCA is merged with actual template */
-                strat = stratCA;
-                /* live groups needed to reach max even color from regionA */
-                find_live_groups_reach(max_col_vertices,regionA.first,strat);
-                return std::make_pair(vertices_, winCA.second); /* winning region is whole set */
-            }
-            else {
-                /* vertices from which player 1 can force to reach losing region of gameCA */
-                auto regionB = solve_reachability_game(winCA.second, {V1});
-                Game gameCB(subgame(regionB.second)); /* game with regionB removed */
-                /* solve gameCB */
-                auto winCB = gameCB.recursive_strategy_template_parity(strat,u+1);
-                return std::make_pair(winCB.first, set_union(winCB.second, regionB.first)); 
-            }
-        }
+        return to_sets(view().recursive_strategy_template_parity(strat, u));
     }
 
     ///////////////////////////////////////////////////////////////
@@ -288,68 +207,171 @@ public:
             return "\"" + print_label(state, true) + "\"";
         }
         if (labels_.empty()) {
-            return std::to_string(state);
+            return std::to_string(graph_.original_id(state));
         }
-        return std::to_string(*edges_.at(state).begin());
-    }
-
-    /* update string parts of the template by replacing edge-states by its label or its(only) successor in a set of edges */
-    int filter_edges(const std::map<size_t, std::set<size_t>>& edges, std::map<size_t, std::set<std::string>>& edge_string, const bool print_actions=false) const {
-        edge_string.clear();
-        for (auto& pair : edges){
-            std::set<std::string> new_succs;
-            for (auto succ : pair.second){
-                new_succs.insert(print_action_edge(succ, print_actions));
-            }
-            edge_string.insert(std::make_pair(pair.first, new_succs));
-        }
-        return 1;
+        return std::to_string(graph_.original_id(successors(state)[0]));
     }
 
     /* filter out edge-states in a template */
-    int filter_templates(Template& assump, const std::set<size_t>& org_vertices, const bool print_actions=false) const {
-        filter_edges(assump.unsafe_edges_, assump.unsafe_strings_, print_actions);
-        filter_edges(assump.colive_edges_, assump.colive_strings_, print_actions);
-        for (auto& live_group : assump.live_groups_){
-            std::map<size_t, std::set<std::string>> live_strings;
-            filter_edges(live_group, live_strings, print_actions);
-            assump.live_groups_strings_.push_back(live_strings);
-        }
-        for (auto& live_groups : assump.cond_live_groups_){
-            std::vector<std::map<size_t, std::set<std::string>>> cond_live_strings;
-            for (auto& live_group : live_groups){
-                std::map<size_t, std::set<std::string>> live_strings;
-                filter_edges(live_group, live_strings, print_actions);
-                cond_live_strings.push_back(live_strings);
-            }
-            assump.cond_live_groups_strings_.push_back(cond_live_strings);
-        }
+    int filter_templates(Template& assump, const std::set<size_t>& org_vertices) const {
         for (auto& cond_sets : assump.cond_sets_){
-            cond_sets = set_intersection(cond_sets, org_vertices);
+            cond_sets = original_ids(set_intersection(cond_sets, org_vertices));
         }
         
         return 1;
     }
 
-    /* filter out edge-states from a winning region, assumption and strategy template */
-    int filter_out_edge_states(std::pair<std::set<size_t>, std::set<size_t>>& winning_region, Template& strat, const bool print_actions=false) const {
+    /* filter out edge-states from a winning region, assumption and strategy template
+     * (the condition sets of the template then refer to the original ids of the vertices, the edges are
+     * printed with print_template where edge-states are replaced by their labels or their successors) */
+    int filter_out_edge_states(std::pair<std::set<size_t>, std::set<size_t>>& winning_region, Template& strat) const {
         if (labels_.empty()){
+            filter_templates(strat, vertices_);
             return 0;
         }
         std::set<size_t> org_vertices;
         for (auto v : vertices_){
-            if (vert_id_.at(v) != 2){
+            if (owner(v) != 2){
                 org_vertices.insert(v);
             }
         }
         winning_region.first = set_intersection(winning_region.first, org_vertices);
         winning_region.second = set_intersection(winning_region.second, org_vertices);
         
-        filter_templates(strat, org_vertices, print_actions);
+        filter_templates(strat, org_vertices);
         return 1;
     }
 
 
+    ///////////////////////////////////////////////////////////////
+    /// Print templates
+    ///////////////////////////////////////////////////////////////
+
+    /* edges of a set grouped by their sources (in the order of the sources and the targets) */
+    std::map<size_t, std::set<size_t>> edge_map(const EdgeSet& edges) const {
+        std::map<size_t, std::set<size_t>> result;
+        for (auto e : edges){
+            result[graph_.edge_source(e)].insert(graph_.edge_target(e));
+        }
+        return result;
+    }
+
+    /* edges of a set as strings: original ids of the sources mapped to the targets (replaced by
+     * their labels or their successors for edge-states) */
+    std::map<size_t, std::set<std::string>> edge_strings(const std::map<size_t, std::set<size_t>>& edges, const bool print_actions=false) const {
+        std::map<size_t, std::set<std::string>> result;
+        for (const auto& pair : edges){
+            std::set<std::string>& succs = result[graph_.original_id(pair.first)];
+            for (auto succ : pair.second){
+                succs.insert(print_action_edge(succ, print_actions));
+            }
+        }
+        return result;
+    }
+
+    /* function: print_edges
+     *
+     * print out all edges of a set */
+    void print_edges(const EdgeSet& edges, const std::string note, const bool print_actions=false) const {
+        if (edges.empty()){
+            return;
+        }
+        std::cout << "\n" << note << ": \n";
+        for (const auto& pair : edge_strings(edge_map(edges), print_actions)){
+            for (const auto& u : pair.second){
+                std::cout << pair.first << " -> " << u << "\n";
+            }
+        }
+    }
+
+    /* function: print_live_group
+     *
+     * print out the edges of a live group in one line */
+    void print_live_group(const std::map<size_t, std::set<size_t>>& live_group, const bool print_actions=false) const {
+        std::cout << "{";
+        size_t counter = 0;
+        for (const auto& pair : edge_strings(live_group, print_actions)){
+            for (const auto& u : pair.second){
+                if (counter == 0){
+                    std::cout << "("<<pair.first << " -> " << u<<")";
+                    counter += 1;
+                }
+                else{
+                    std::cout << ", " <<"("<< pair.first << " -> " << u<<")";
+                }
+            }
+        }
+        std::cout << "}\n";
+    }
+
+    /* function: print_live_groups
+     *
+     * print out all live groups (in the order of their sources and targets) */
+    void print_live_groups(const std::vector<LiveGroup>& live_groups, const std::string note, const bool print_actions=false) const {
+        if (live_groups.empty()){
+            return;
+        }
+        std::cout << "\n" << note << ": \n";
+        std::vector<std::map<size_t, std::set<size_t>>> live_group_maps;
+        for (const auto& live_group : live_groups){
+            live_group_maps.push_back(edge_map(*live_group));
+        }
+        std::sort(live_group_maps.begin(), live_group_maps.end());
+        for (const auto& live_group : live_group_maps){
+            print_live_group(live_group, print_actions);
+        }
+    }
+
+    /* function: print_cond_live_groups
+     *
+     * print out all conditional live groups (the condition sets are already in original ids) */
+    void print_cond_live_groups(const Template& strat, const std::string note, const bool print_actions=false) const {
+        if (strat.cond_live_groups_.empty()){
+            return;
+        }
+        std::cout << "\n" << note << ": \n";
+        for (size_t i = 0; i < strat.cond_sets_.size(); i++){
+            const auto& set = strat.cond_sets_[i];
+            for (const auto& live_group : strat.cond_live_groups_[i]){
+                std::cout << "{";
+                for (auto u=set.begin(); u != set.end();){
+                    std::cout << *u;
+                    ++u;
+                    if (u != set.end())
+                        std::cout << ", ";
+                }
+                std::cout << "}: ";
+                print_live_group(edge_map(*live_group), print_actions);
+            }
+        }
+    }
+
+    /* function: print_template
+     *
+     * print out the whole template (with actions instead of edges if print_actions is true) */
+    void print_template(const Template& strat, const bool print_actions=false) const {
+        print_edges(strat.unsafe_edges_, "Unsafe edges", print_actions);
+        print_edges(strat.colive_edges_, "Colive edges", print_actions);
+        print_live_groups(strat.live_groups_, "Live groups", print_actions);
+        print_cond_live_groups(strat, "Conditional live groups", print_actions);
+        if (strat.empty()){
+            std::cout << "\nTRUE\n";
+        }
+    }
+
+    /* function: print_template_size
+     *
+     * print out size of all template (unsafe and colive edges are counted by their sources) */
+    void print_template_size(Template& strat) const {
+        strat.clean();
+        std::cout << "\n";
+        std::cout << "#unsafe_edges:     "<< edge_map(strat.unsafe_edges_).size()<<"\n";
+        std::cout << "#colive_edges:     "<< edge_map(strat.colive_edges_).size()<<"\n";
+        std::cout << "#live_groups:      "<< strat.size_live() <<"\n";
+        // std::cout << "#cond_live_groups: "<< strat.size_cond_live() <<"\n";
+    }
+
+
     ///////////////////////////////////////////////////////////////
     /// Convert to local templates for each state and print
     ///////////////////////////////////////////////////////////////
@@ -362,10 +384,10 @@ public:
 
         // iterate through each state in the game
         for (auto state : winning_states){
-            if (vert_id_.at(state) != 0){/* only consider player 0 states */
+            if (owner(state) != 0){/* only consider player 0 states */
                 continue;
             }
-            auto id = state;
+            auto id = graph_.original_id(state);
             std::string name = "";
             if (!state_names_.empty()){
                 name = state_names_.at(state);
@@ -379,23 +401,27 @@ public:
             std::set<std::string> live_actions;
             std::set<std::string> unrestricted_actions;
             std::set<std::string> preferred_actions;
-            for (const auto& succ : edges_.at(state)){
+            for (const auto& succ : successors(state)){
                 all_actions.insert(print_action_edge(succ,print_actions));
                 unrestricted.insert(succ);
             }
-            for (const auto& succ : temp.unsafe_edges_[state]){
-                unsafe_actions.insert(print_action_edge(succ,print_actions));
-                unrestricted.erase(succ);
-            }
-            for (const auto& succ : temp.colive_edges_[state]){
-                colive_actions.insert(print_action_edge(succ,print_actions));
-                unrestricted.erase(succ);
-            }
-            for (auto& live_group : temp.live_groups_){
-                for (const auto& succ : live_group[state]){
-                    live_actions.insert(print_action_edge(succ,print_actions));
+            for (size_t i = graph_.succ_begin_[state]; i < graph_.succ_begin_[state+1]; i++){
+                size_t succ = graph_.succ_[i];
+                size_t e = graph_.edge_id(i);
+                if (temp.has_edge(temp.unsafe_edges_, e)){
+                    unsafe_actions.insert(print_action_edge(succ,print_actions));
+                    unrestricted.erase(succ);
+                }
+                if (temp.has_edge(temp.colive_edges_, e)){
+                    colive_actions.insert(print_action_edge(succ,print_actions));
                     unrestricted.erase(succ);
                 }
+                for (const auto& live_group : temp.live_groups_){
+                    if (temp.has_edge(*live_group, e)){
+                        live_actions.insert(print_action_edge(succ,print_actions));
+                        unrestricted.erase(succ);
+                    }
+                }
             }
             for (const auto& succ : unrestricted){
                 unrestricted_actions.insert(print_action_edge(succ,print_actions));
@@ -458,8 +484,8 @@ public:
     /* function: check_set_inclusion
      *
      * check if set1 is included in set2 */
-    template<class T>
-    bool check_set_inclusion(const std::set<T>& set1, const std::set<T>& set2) const {
+    template<class Set, class T>
+    bool check_set_inclusion(const Set& set1, const std::set<T>& set2) const {
         if (set2.empty()){
             return false;
         }
@@ -474,8 +500,8 @@ public:
     /* function: check_set_intersection
      *
      * check if there is nonempty intersection between the two sets */
-    template<class T>
-    bool check_set_intersection(const std::set<T>& set1, const std::set<T>& set2) const {
+    template<class Set, class T>
+    bool check_set_intersection(const Set& set1, const std::set<T>& set2) const {
         for (auto a = set1.begin(); a != set1.end(); ++a) {
             if (set2.find(*a) != set2.end()) {
                 return true;
@@ -544,26 +570,61 @@ public:
         }
     }
 
-    /* function: map_remove_vertices
+    /* function: edges_remove_vertices
      *
-     * remove set of keys and values from one map */
-    void map_remove_vertices(std::map<size_t, std::set<size_t>>& map, const std::set<size_t>& keys) const {
-        map_remove_keys(map, keys);
-        map_remove_values(map,keys);
+     * remove the edges from or to a vertex of the set from a set of edges */
+    void edges_remove_vertices(EdgeSet& edges, const std::set<size_t>& set) const {
+        std::erase_if(edges, [&](const size_t e){
+            return set.find(graph_.edge_source(e)) != set.end() || set.find(graph_.edge_target(e)) != set.end();
+        });
+    }
+
+    /* function: edges_remove_sources
+     *
+     * remove the edges from a vertex of the set from a set of edges */
+    void edges_remove_sources(EdgeSet& edges, const std::set<size_t>& set) const {
+        std::erase_if(edges, [&](const size_t e){
+            return set.find(graph_.edge_source(e)) != set.end();
+        });
     }
 
     /* function: max_col
      *
      * compute the max_color the game */
-    size_t max_col(std::map<size_t,size_t>& colors) const {
+    size_t max_col(const ColorMap& colors) const {
         size_t max_color = 0;
-        for (auto pair : colors){
-            if (pair.second > max_color)
-                max_color = pair.second;
+        for (auto v : vertices_){
+            if (colors[v] > max_color)
+                max_color = colors[v];
         }
         return max_color;
     }
 
+    /* function: vertex_set
+     *
+     * set of vertices as a bitset over all vertices of the graph */
+    VertexSet vertex_set(const std::set<size_t>& set) const {
+        return VertexSet(graph_.n_vert_, set);
+    }
+
+    /* function: to_sets
+     *
+     * convert a pair of bitsets (e.g. winning and losing region) to sets */
+    std::pair<std::set<size_t>, std::set<size_t>> to_sets(const std::pair<VertexSet, VertexSet>& sets) const {
+        return std::make_pair(sets.first.to_set(), sets.second.to_set());
+    }
+
+    /* function: vertex_mask
+     *
+     * indicator vector of a set of vertices */
+    std::vector<bool> vertex_mask(const std::set<size_t>& set) const {
+        std::vector<bool> mask(graph_.n_vert_, false);
+        for (auto v : set){
+            mask[v] = true;
+        }
+        return mask;
+    }
+
     /* function: remove_vertices
      *
      * remove vertices from the game */
@@ -571,17 +632,10 @@ public:
     void remove_vertices(const std::set<size_t>& set) {
         vertices_= set_complement(set);
         n_vert_ = vertices_.size();
-        map_remove_keys(vert_id_, set);
-        
-        map_remove_keys(colors_, set);
         max_color_ = max_col(colors_);
         
-        map_remove_keys(edges_, set);
-        n_edge_ = 0;
-        for (auto v : vertices_){
-            edges_.at(v) = set_difference(edges_.at(v),set);
-            n_edge_ += edges_.at(v).size();
-        }
+        graph_ = graph_.restrict(vertex_mask(vertices_));
+        n_edge_ = graph_.n_edge_;
         /* sanity check */
         // valid_game();
     }
@@ -594,20 +648,10 @@ public:
         Game game(*this);
         game.n_vert_ = set.size();
         game.vertices_= set;
+        game.max_color_ = game.max_col(game.colors_);
 
-        std::set<size_t> complement = set_complement(set);
-        map_remove_keys(game.vert_id_, complement);
-        map_remove_keys(game.colors_, complement);
-        game.max_color_ = max_col(game.colors_);
-        
-
-        
-        map_remove_keys(game.edges_, complement);
-        game.n_edge_ = 0;
-        for (auto v : game.vertices_){
-            game.edges_.at(v) = set_difference(game.edges_.at(v),complement);
-            game.n_edge_ += game.edges_.at(v).size();
-        }
+        game.graph_ = graph_.restrict(vertex_mask(set));
+        game.n_edge_ = game.graph_.n_edge_;
         /* sanity check */
         // game.valid_game();
         
@@ -616,9 +660,9 @@ public:
 
     /* check valid_game */
     void valid_game() const {
-        if (n_vert_ != vertices_.size() || n_vert_ != edges_.size() || n_vert_ != vert_id_.size() || n_vert_ != colors_.size()){
+        if (n_vert_ != vertices_.size() || n_edge_ != graph_.n_edge_ || graph_.n_vert_ != graph_.owner_.size() || graph_.n_vert_ != colors_.size()){
             std::cerr << "ERROR: Invalid Game ###############.\n";
-            std::cout << "vertex:"<<n_vert_ <<"," << vertices_.size()<<"   edges"<< n_edge_ <<","<<edges_.size()<< "  vert_id:" << vert_id_.size() << " color:"<<colors_.size()<<"\n";
+            std::cout << "vertex:"<<n_vert_ <<"," << vertices_.size()<<"   edges"<< n_edge_ <<","<<graph_.n_edge_<< "  vert_id:" << graph_.owner_.size() << " color:"<<colors_.size()<<"\n";
         }
     }
     
@@ -665,44 +709,30 @@ public:
      *
      * return all plyaer 0's edges from source to target */
     
-    std::map<size_t, std::set<size_t>>  edges_between(const std::set<size_t>& source, const std::set<size_t>& target) const {
-        std::map<size_t, std::set<size_t>> result_edges;
-        /* include every player 0 edge from source to target */
+    EdgeSet edges_between(const std::set<size_t>& source, const std::set<size_t>& target) const {
+        EdgeSet result_edges;
+        /* include every player 0 edge from source to target (the sources are increasing, so are the edge ids) */
         for (auto v : source){
-            if (vert_id_.at(v) == V0){
-                for (auto u : edges_.at(v)){
-                    if (target.find(u) != target.end()){
-                        result_edges[v].insert(u);
+            if (owner(v) == V0){
+                for (size_t i = graph_.succ_begin_[v]; i < graph_.succ_begin_[v+1]; i++){
+                    if (target.find(graph_.succ_[i]) != target.end()){
+                        result_edges.push_back(graph_.edge_id(i));
                     }
                 }
             }
         }
         return result_edges;
     }
-    void edges_between(const std::set<size_t>& source,
-                       const std::set<size_t>& target,
-                       std::map<size_t, std::set<size_t>>& result_edges) const {
-        /* include every player 0 edge from source to target */
-        for (auto v : source){
-            if (vert_id_.at(v) == V0){
-                for (auto u : edges_.at(v)){
-                    if (target.find(u) != target.end()){
-                        result_edges[v].insert(u);
-                    }
-                }
-            }
-        }
-    }
-    std::map<size_t, std::set<size_t>> edges_between(const std::set<size_t>& source,
+    EdgeSet edges_between(const std::set<size_t>& source,
                         const std::set<size_t>& target,
                         std::set<size_t>& new_sources) const {
-        std::map<size_t, std::set<size_t>> result_edges;
+        EdgeSet result_edges;
         /* include every player 0 edge from source to target */
         for (auto v : source){
-            if (vert_id_.at(v) == V0){
-                for (auto u : edges_.at(v)){
-                    if (target.find(u) != target.end()){
-                        result_edges[v].insert(u);
+            if (owner(v) == V0){
+                for (size_t i = graph_.succ_begin_[v]; i < graph_.succ_begin_[v+1]; i++){
+                    if (target.find(graph_.succ_[i]) != target.end()){
+                        result_edges.push_back(graph_.edge_id(i));
                         new_sources.insert(v);
                     }
                 }
@@ -714,30 +744,34 @@ public:
     /* function: co_edges_between
      *
      * add all plyaer i's edges that are from source but not to target (and there is an edge from that source to target) */
-    std::map<size_t, std::set<size_t>> co_edges_between(const std::set<size_t>& source,
+    EdgeSet co_edges_between(const std::set<size_t>& source,
                         const std::set<size_t>& target,
                         std::set<size_t>& new_sources,
-                        std::map<size_t, std::set<size_t>>& result_edges,
+                        EdgeSet& result_edges,
                         const std::set<size_t>& players = {V0}) const {
+        EdgeSet new_edges;
         /* include every player i edge from source but not to target when there is an edge from source to target */
         for (auto v : source){
             bool colive_source = false; /* if there is an edge from this source to target */
-            std::set<size_t> colive_neighbours; /* all neighbours of this source that is not a target */
-            if (players.find(vert_id_.at(v)) != players.end()){
-                for (auto u : edges_.at(v)){
-                    if (target.find(u) == target.end()){
-                        colive_neighbours.insert(u);
+            EdgeSet colive_neighbours; /* all edges of this source that do not lead to a target */
+            if (players.find(owner(v)) != players.end()){
+                for (size_t i = graph_.succ_begin_[v]; i < graph_.succ_begin_[v+1]; i++){
+                    if (target.find(graph_.succ_[i]) == target.end()){
+                        colive_neighbours.push_back(graph_.edge_id(i));
                     }
                     else{
                         colive_source = true;
                     }
                 }
                 if(colive_source){ /* if there is an edge from source to target then add the edges to colive_neighbours */
-                    set_merge(result_edges[v], colive_neighbours);
+                    new_edges.insert(new_edges.end(), colive_neighbours.begin(), colive_neighbours.end());
                     new_sources.insert(v);
                 }
             }
         }
+        EdgeSet merged;
+        std::set_union(result_edges.begin(), result_edges.end(), new_edges.begin(), new_edges.end(), std::back_inserter(merged));
+        result_edges.swap(merged);
         return result_edges;
     }
 
@@ -779,7 +813,8 @@ public:
         std::string output_num;
         size_t start = 1;
         for (size_t i = 0; i < ap_id_.size(); i++){
-            if (labels_.at(u)[i] == 0){
+            size_t literal = labels_.get(u, i);
+            if (literal == NEG){
                 if (start == 1){
                     start = 0;
                     output += "!"+ap_id_.at(i);
@@ -790,7 +825,7 @@ public:
                     output_num += "&!" + std::to_string(i);
                 }
             }
-            else if (labels_.at(u)[i] == 1){
+            else if (literal == POS){
                 if (start == 1){
                     start = 0;
                     output += ap_id_.at(i);
@@ -0,0 +1,716 @@
+/*
+ * Class: GameView
+ *
+ *  Class formalizing a subgame as a view on the graph and colors of a game
+ */
+
+#ifndef GAMEVIEW_HPP_
+#define GAMEVIEW_HPP_
+
+#include "Template.hpp"
+#include "Graph.hpp"
+#include "VertexSet.hpp"
+#include "ColorIndex.hpp"
+#include <memory>
+
+namespace mpa {
+/* class for a subgame restricted to a set of vertices: the graph and the colors are not copied
+ * but shared with the game the view is created from (which has to outlive the view) */
+class GameView {
+public:
+    /* graph of the game (edges to vertices outside the view are ignored) */
+    const Graph* graph_;
+    /* colors of the vertices of the graph */
+    ColorMap colors_;
+    /* vertices of the subgame (always in the dense representation) */
+    VertexSet vertices_;
+    /* number of vertices */
+    size_t n_vert_;
+    /* maximum of colors */
+    size_t max_color_;
+    /* buckets of vertices with the same color (shared by the view and all of its subgames) */
+    std::shared_ptr<const ColorIndex> index_;
+    /* vertex v of the graph is the vertex index_first_+v of the buckets (see scc_strategy_template_parity) */
+    size_t index_first_ = 0;
+    /* number of vertices of the view with color c */
+    std::vector<size_t> color_count_;
+public:
+    /* constructor with a given maximum color */
+    GameView(const Graph& graph, const ColorMap& colors, VertexSet vertices, const size_t max_color):
+        graph_(&graph), colors_(colors), vertices_(std::move(vertices)), max_color_(max_color) {
+        vertices_.make_dense();
+        n_vert_ = vertices_.size();
+        index_ = std::make_shared<const ColorIndex>(colors, vertices_);
+        color_count_.assign(index_->max_color_+1, 0);
+        for (size_t c = 0; c <= index_->max_color_; c++){
+            color_count_[c] = index_->bucket(c).size();
+        }
+    }
+
+    /* constructor (the maximum color is computed over the vertices) */
+    GameView(const Graph& graph, const ColorMap& colors, VertexSet vertices):
+        GameView(graph, colors, std::move(vertices), 0) {
+        max_color_ = index_->max_color_;
+    }
+
+    /* constructor with given buckets, in which vertex v of the graph is the vertex first+v (the colors
+     * are counted over the vertices, the buckets are not rebuilt) */
+    GameView(const Graph& graph, const ColorMap& colors, VertexSet vertices,
+             std::shared_ptr<const ColorIndex> index, const size_t first):
+        graph_(&graph), colors_(colors), vertices_(std::move(vertices)), max_color_(0),
+        index_(std::move(index)), index_first_(first) {
+        vertices_.make_dense();
+        n_vert_ = vertices_.size();
+        if (!colors_.empty()){
+            for (auto v : vertices_){
+                max_color_ = std::max(max_color_, colors_[v]);
+            }
+        }
+        color_count_.assign(max_color_+1, 0);
+        if (!colors_.empty()){
+            for (auto v : vertices_){
+                color_count_[colors_[v]] += 1;
+            }
+        }
+    }
+
+    /* constructor of a subgame of parent restricted to vertices (only the counts of the colors
+     * of the removed vertices are updated) */
+    GameView(const GameView& parent, VertexSet vertices):
+        graph_(parent.graph_), colors_(parent.colors_), vertices_(std::move(vertices)),
+        index_(parent.index_), index_first_(parent.index_first_), color_count_(parent.color_count_) {
+        vertices_.make_dense();
+        vertices_ &= parent.vertices_;
+        n_vert_ = vertices_.size();
+        for (auto v : parent.vertices_ - vertices_){
+            color_count_[colors_[v]] -= 1;
+        }
+        /* the maximum color with a vertex left */
+        max_color_ = std::min(parent.max_color_, color_count_.size()-1);
+        while (max_color_ > 0 && color_count_[max_color_] == 0){
+            max_color_ -= 1;
+        }
+    }
+
+    /* owner of vertex v */
+    size_t owner(const size_t v) const {
+        return graph_->owner(v);
+    }
+
+    /* function: subgame
+     *
+     * returns a view restricted to this set (of vertices of the view) */
+    GameView subgame(VertexSet set) const {
+        return GameView(*this, std::move(set));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Solving reachability and parity games
+    ///////////////////////////////////////////////////////////////
+
+    /* solve reachability game for player i (default is player 0)
+     * input: target
+     * output: Reach_i(target)
+     * (with players = {} the vertices from which no player can avoid the target) */
+    std::pair<VertexSet, VertexSet> solve_reachability_game(const VertexSet& target,
+                                                    const std::set<size_t>& players = {V0}) const {
+        if (target.empty()){ /* nothing can reach an empty target */
+            return std::make_pair(target, vertices_);
+        }
+        /* a vertex of the players is attracted by one winning successor, others by all of them */
+        std::vector<bool> choose(256, false);
+        for (auto i : players){
+            choose[i & 255] = true;
+        }
+
+        VertexSet winning(graph_->n_vert_); /* vertices from which targets are reachable */
+        winning.make_dense();
+        std::vector<size_t> remaining(graph_->n_vert_, 0); /* number of successors not yet winning */
+        std::vector<size_t> worklist; /* winning vertices whose predecessors are not yet processed */
+        for (auto v : target){
+            if (vertices_.contains(v)){
+                winning.insert(v);
+                worklist.push_back(v);
+            }
+        }
+        for (auto v : vertices_){
+            for (auto u : graph_->successors(v)){
+                remaining[v] += vertices_.contains(u);
+            }
+            if (remaining[v] == 0 && !winning.contains(v)){ /* every successor of a dead-end is (vacuously) winning */
+                winning.insert(v);
+                worklist.push_back(v);
+            }
+        }
+        while (!worklist.empty()){
+            size_t u = worklist.back();
+            worklist.pop_back();
+            for (auto v : graph_->predecessors(u)){
+                if (!vertices_.contains(v) || winning.contains(v)){
+                    continue;
+                }
+                remaining[v] -= 1;
+                if (choose[owner(v)] || remaining[v] == 0){
+                    winning.insert(v);
+                    worklist.push_back(v);
+                }
+            }
+        }
+
+        /* target and the attracted vertices, and the vertices from which targets might not be reachable */
+        return std::make_pair(winning | target, vertices_ - winning);
+    }
+
+    /* recursive zielonka's algorithm */
+    std::pair<VertexSet, VertexSet> recursive_zielonka_parity() const {
+        if (n_vert_ == 0) /* if current region is empty, nothing to do, return empty */
+            return std::make_pair(vertices_, vertices_);
+        if (is_buchi()) /* colors 1 and 2 */
+            return solve_buchi_game(vertex_with_color(2));
+        if (is_cobuchi()) /* colors 0 and 1 */
+            return solve_cobuchi_game(vertex_with_color(0));
+        /* vertices with maximum color */
+        VertexSet max_col_vertices = vertex_with_color(max_color_);
+        if (max_color_ % 2 == 1){ /* when max_color_ is odd */
+            /* vertices from which player 1 can force to visit max_col_vertices (odd) */
+            auto regionA = solve_reachability_game(max_col_vertices, {V1});
+            /* complement of regionA */
+            GameView gameCA(subgame(std::move(regionA.second))); /* game with regionA removed */
+            /* solve the gameCA */
+            auto winCA = gameCA.recursive_zielonka_parity();
+            if (winCA.first.empty()) /* if winning region is empty in gameCA then return everything empty */
+                return std::make_pair(winCA.first, vertices_);
+            else {
+                /* vertices from which player 0 can force to reach winning region of gameCA */
+                auto regionB = solve_reachability_game(winCA.first, {V0});
+                GameView gameCB(subgame(std::move(regionB.second))); /* game with regionB removed */
+                /* solve gameCB */
+                auto winCB = gameCB.recursive_zielonka_parity();
+                return std::make_pair(set_union(winCB.first, regionB.first), winCB.second); /* winning region is regionB \cup winning region of gameCB */
+            }
+        }
+        else{ /* max_color_ is even */
+            /* vertices from which player 0 can force to visit max_col_vertices (even) */
+            auto regionA = solve_reachability_game(max_col_vertices, {V0});
+            /* complement of regionA */
+            GameView gameCA(subgame(std::move(regionA.second))); /* game with regionA removed */
+            /* solve the gameCA */
+            auto winCA = gameCA.recursive_zielonka_parity();
+            if (winCA.second.empty()){ /* if losing region is empty */
+                return std::make_pair(vertices_, winCA.second); /* winning region is whole set */
+            }
+            else {
+                /* vertices from which player 1 can force to reach losing region of gameCA */
+                auto regionB = solve_reachability_game(winCA.second, {V1});
+                GameView gameCB(subgame(std::move(regionB.second))); /* game with regionB removed */
+                /* solve gameCB */
+                auto winCB = gameCB.recursive_zielonka_parity();
+                return std::make_pair(winCB.first, set_union(winCB.second, regionB.first)); /* winning region is winning region of gameCB */
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Buechi and co-Buechi games
+    ///////////////////////////////////////////////////////////////
+
+    /* if the colors of the view are 1 and 2 (Buechi game for the vertices with color 2) */
+    bool is_buchi() const {
+        return max_color_ == 2 && color_count_[0] == 0;
+    }
+
+    /* if the colors of the view are 0 and 1 (co-Buechi game for the vertices with color 0) */
+    bool is_cobuchi() const {
+        return max_color_ <= 1;
+    }
+
+    /* solve Buechi game (Always Eventually [target]) by the nested fixpoint: the vertices from which player 1
+     * can avoid the target forever are removed (with their attractor) until player 0 can reach the target from
+     * everywhere; if strat is given, the live groups to reach the target are added to it
+     * (the same winning region and template as the parity algorithms with color 2 on target and 1 elsewhere) */
+    std::pair<VertexSet, VertexSet> solve_buchi_game(const VertexSet& target, Template* strat = nullptr) const {
+        GameView game(*this, vertices_); /* game with the vertices removed so far */
+        while (true){
+            VertexSet curr_target = game.vertices_ & target;
+            if (curr_target.empty()){ /* player 0 can not visit the target */
+                return std::make_pair(VertexSet(graph_->n_vert_), vertices_);
+            }
+            /* vertices from which player 0 can force to visit the target */
+            auto regionA = game.solve_reachability_game(curr_target, {V0});
+            if (regionA.second.empty()){
+                if (strat){
+                    /* live groups needed to reach the target from everywhere */
+                    game.find_live_groups_reach(curr_target, regionA.first, *strat);
+                }
+                return std::make_pair(game.vertices_, vertices_ - game.vertices_);
+            }
+            /* vertices from which player 1 can force to visit the region avoiding the target */
+            auto regionB = game.solve_reachability_game(regionA.second, {V1});
+            game = game.subgame(std::move(regionB.second));
+        }
+    }
+
+    /* solve co-Buechi game (Eventually Always [target]) by the nested fixpoint: the vertices from which player 0
+     * can stay in the target forever are added (with their attractor) until player 1 can visit the rest of the
+     * game from everywhere; if strat is given, the player 0's edges leaving the region are colive and the live
+     * groups to reach the region are added to it (the same winning region and template as the parity algorithms
+     * with color 0 on target and 1 elsewhere) */
+    std::pair<VertexSet, VertexSet> solve_cobuchi_game(const VertexSet& target, Template* strat = nullptr) const {
+        VertexSet winning(graph_->n_vert_); /* vertices won by player 0 so far */
+        GameView game(*this, vertices_); /* game with the vertices removed so far */
+        while (true){
+            VertexSet outside = game.vertices_ - target;
+            if (outside.empty()){ /* the rest of the game is in the target */
+                winning |= game.vertices_;
+                return std::make_pair(winning, VertexSet(graph_->n_vert_));
+            }
+            /* vertices from which player 1 can force to leave the target */
+            auto regionA = game.solve_reachability_game(outside, {V1});
+            if (regionA.second.empty()){
+                return std::make_pair(winning, game.vertices_);
+            }
+            /* vertices from which player 0 can force to reach the region where the target can not be left */
+            auto regionB = game.solve_reachability_game(regionA.second, {V0});
+            if (strat){
+                /* edges from the region to the rest of the game (all are player 0's) are colive */
+                strat->edge_merge(strat->colive_edges_, game.edges_between(regionA.second, game.set_complement(regionA.second)));
+                /* live groups needed to reach the region from regionB */
+                game.find_live_groups_reach(regionA.second, regionB.first, *strat);
+            }
+            winning |= regionB.first;
+            game = game.subgame(std::move(regionB.second));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Strategy templates
+    ///////////////////////////////////////////////////////////////
+
+    /* live groups needed to reach target from every vertex of winning_region
+     *
+     * the layers are computed in one backward sweep: a layer is the set of vertices from which no player
+     * can avoid the previous layers, and the player 0's edges from the other vertices into it form a live
+     * group whose sources are added to the next layer (the counters of the remaining successors are kept
+     * from layer to layer, so every edge is visited a constant number of times) */
+    void find_live_groups_reach(const VertexSet& target,
+                                const VertexSet& winning_region,
+                                Template& strat) const {
+        if (target.empty()){ /* nothing can reach an empty target */
+            return;
+        }
+        VertexSet attracted(graph_->n_vert_); /* vertices of the layers so far */
+        attracted.make_dense();
+        size_t n_outside = (target - vertices_).size(); /* the target vertices outside the view also count */
+        std::vector<size_t> remaining(graph_->n_vert_, 0); /* number of successors not yet attracted */
+        std::vector<bool> candidate(graph_->n_vert_, false); /* if a vertex is a source of the next live group */
+        std::vector<size_t> worklist; /* attracted vertices whose predecessors are not yet processed */
+        std::vector<size_t> sources; /* player 0's vertices with an edge into the attracted vertices */
+        for (auto v : target){
+            if (vertices_.contains(v)){
+                attracted.insert(v);
+                worklist.push_back(v);
+            }
+        }
+        for (auto v : vertices_){
+            for (auto u : graph_->successors(v)){
+                remaining[v] += vertices_.contains(u);
+            }
+            if (remaining[v] == 0 && !attracted.contains(v)){ /* every successor of a dead-end is (vacuously) attracted */
+                attracted.insert(v);
+                worklist.push_back(v);
+            }
+        }
+        while (true){
+            /* vertices from which no player can avoid the attracted vertices */
+            while (!worklist.empty()){
+                size_t u = worklist.back();
+                worklist.pop_back();
+                for (auto v : graph_->predecessors(u)){
+                    if (!vertices_.contains(v) || attracted.contains(v)){
+                        continue;
+                    }
+                    remaining[v] -= 1;
+                    if (remaining[v] == 0){
+                        attracted.insert(v);
+                        worklist.push_back(v);
+                    }
+                    else if (owner(v) == V0 && !candidate[v]){
+                        candidate[v] = true;
+                        sources.push_back(v);
+                    }
+                }
+            }
+            if (attracted.size() + n_outside == winning_region.size()){
+                break;
+            }
+            /* live group containing player 0's edges from outside into the attracted vertices */
+            std::erase_if(sources, [&](const size_t v){ return attracted.contains(v); });
+            if (sources.empty()){ /* no more vertex can be attracted */
+                break;
+            }
+            std::sort(sources.begin(), sources.end());
+            EdgeSet live_group;
+            for (auto v : sources){
+                for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1]; i++){
+                    if (attracted.contains(graph_->succ_[i])){
+                        live_group.push_back(graph_->edge_id(i));
+                    }
+                }
+            }
+            strat.add_live_group(std::move(live_group));
+            /* the sources start the next layer */
+            for (auto v : sources){
+                candidate[v] = false;
+                attracted.insert(v);
+                worklist.push_back(v);
+            }
+            sources.clear();
+        }
+    }
+
+    /* compute the set of live groups and colive edges recursively */
+    std::pair<VertexSet, VertexSet> recursive_strategy_template_parity(
+                                    Template& strat,
+                                    const size_t& u = 0) const {
+        if (n_vert_ == 0) /* if current region is empty, nothing to do, return empty */
+            return std::make_pair(vertices_, vertices_);
+        if (is_buchi()) /* colors 1 and 2 */
+            return solve_buchi_game(vertex_with_color(2), &strat);
+        if (is_cobuchi()) /* colors 0 and 1 */
+            return solve_cobuchi_game(vertex_with_color(0), &strat);
+        /* vertices with maximum color */
+        VertexSet max_col_vertices = vertex_with_color(max_color_);
+        if (max_color_ % 2 == 1){ /* when max_color_ is odd */
+            /* vertices from which player 1 can force to visit max_col_vertices (odd) */
+            auto regionA = solve_reachability_game(max_col_vertices, {V1});
+            /* complement of regionA */
+            GameView gameCA(subgame(std::move(regionA.second))); /* game with regionA removed */
+            /* solve the gameCA */
+            auto winCA = gameCA.recursive_strategy_template_parity(strat,u+1);
+            if (winCA.first.empty()) /* if winning region is empty in gameCA then return everything empty */
+                return std::make_pair(winCA.first, vertices_);
+            else {
+                /* vertices from which player 0 can force to reach winning region of gameCA */
+                auto regionB = solve_reachability_game(winCA.first, {V0});
+                /* edges from winning region of gameCA to regionB (all are player 0's) are colive */
+                strat.edge_merge(strat.colive_edges_, edges_between(winCA.first,set_complement(winCA.first)));
+                /* live groups needed to reach winCA from regionB */
+                find_live_groups_reach(winCA.first,regionB.first,strat);
+
+                GameView gameCB(subgame(std::move(regionB.second))); /* game with regionB removed */
+                /* solve gameCB */
+                auto winCB = gameCB.recursive_strategy_template_parity(strat,u+1);
+                return std::make_pair(set_union(winCB.first, regionB.first), winCB.second); /* winning region is regionB \cup winning region of gameCB */
+            }
+        }
+        else{ /* max_color_ is even */
+            /* vertices from which player 0 can force to visit max_col_vertices (even) */
+            auto regionA = solve_reachability_game(max_col_vertices, {V0});
+            /* complement of regionA */
+            GameView gameCA(subgame(std::move(regionA.second))); /* game with regionA removed */
+            /* solve the gameCA (its template is directly collected in the actual template) */
+            auto winCA = gameCA.recursive_strategy_template_parity(strat,u+1);
+            if (winCA.second.empty()){ /* if losing region is empty */
+                /* live groups needed to reach max even color from regionA */
+                find_live_groups_reach(max_col_vertices,regionA.first,strat);
+                return std::make_pair(vertices_, winCA.second); /* winning region is whole set */
+            }
+            else {
+                /* vertices from which player 1 can force to reach losing region of gameCA */
+                auto regionB = solve_reachability_game(winCA.second, {V1});
+                GameView gameCB(subgame(std::move(regionB.second))); /* game with regionB removed */
+                /* solve gameCB */
+                auto winCB = gameCB.recursive_strategy_template_parity(strat,u+1);
+                return std::make_pair(winCB.first, set_union(winCB.second, regionB.first));
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Solving by SCC decomposition
+    ///////////////////////////////////////////////////////////////
+
+    /* compute the set of live groups and colive edges bottom-up along the SCCs of the view
+     *
+     * the components whose successors are all decided are solved as subgames (concurrently, as there are no
+     * edges between them) and the attractors of their winning regions are decided in the remaining game;
+     * the templates of the components are merged with the live groups of the attractor of player 0
+     * (a view with dead-ends is solved as a whole: the attractors of both players contain the dead-ends, so
+     * that they are won by the player whose attractor is computed first in the whole view)
+     *
+     * every component is solved on its own graph, renumbered in the order of its vertices (with the edge ids
+     * of the game, so that its template needs no mapping), and on its slice of one index of the buckets of
+     * all components, so that its work does not depend on the size of the game; the attractors of the
+     * levels share the counters of the undecided successors of all vertices */
+    std::pair<VertexSet, VertexSet> scc_strategy_template_parity(Template& strat) const {
+        for (auto v : vertices_){
+            bool dead_end = true;
+            for (auto u : graph_->successors(v)){
+                dead_end = dead_end && !vertices_.contains(u);
+            }
+            if (dead_end){
+                return recursive_strategy_template_parity(strat);
+            }
+        }
+        std::vector<size_t> component;
+        size_t n_comp = graph_->strongly_connected_components(vertices_, component);
+        /* vertices of every component */
+        std::vector<std::vector<size_t>> scc_vertices(n_comp);
+        for (auto v : vertices_){
+            scc_vertices[component[v]].push_back(v);
+        }
+        /* level of the components: 0 for bottom components and one more than the maximum level of the
+         * successor components otherwise (successors have smaller numbers) */
+        std::vector<size_t> level(n_comp, 0);
+        std::vector<std::vector<size_t>> level_sccs; /* components of every level */
+        for (size_t c = 0; c < n_comp; c++){
+            for (auto v : scc_vertices[c]){
+                for (auto u : graph_->successors(v)){
+                    if (vertices_.contains(u) && component[u] != c){
+                        level[c] = std::max(level[c], level[component[u]]+1);
+                    }
+                }
+            }
+            if (level[c] >= level_sccs.size()){
+                level_sccs.resize(level[c]+1);
+            }
+            level_sccs[level[c]].push_back(c);
+        }
+
+        /* the vertices of the components one after the other: local[v] is the id of v in the graph of its
+         * component, which starts at position first[c] of the buckets and colors of all components */
+        std::vector<size_t> first(n_comp+1, 0);
+        std::vector<size_t> local(graph_->n_vert_, Graph::npos);
+        std::vector<size_t> position(graph_->n_vert_, ColorIndex::npos);
+        std::vector<size_t> scc_colors(colors_.empty() ? 0 : n_vert_);
+        for (size_t c = 0; c < n_comp; c++){
+            first[c+1] = first[c] + scc_vertices[c].size();
+            for (size_t l = 0; l < scc_vertices[c].size(); l++){
+                size_t v = scc_vertices[c][l];
+                local[v] = l;
+                position[v] = first[c] + l;
+                if (!colors_.empty()){
+                    scc_colors[first[c] + l] = colors_[v];
+                }
+            }
+        }
+        auto index = std::make_shared<const ColorIndex>(*index_, position);
+
+        /* layer in which every vertex is decided (npos for the undecided ones), and the number of undecided
+         * successors of every vertex */
+        std::vector<size_t> layer_of(graph_->n_vert_, Graph::npos);
+        size_t n_layers = 0;
+        std::vector<size_t> remaining(graph_->n_vert_, 0);
+        for (auto v : vertices_){
+            for (auto u : graph_->successors(v)){
+                remaining[v] += vertices_.contains(u);
+            }
+        }
+        std::vector<size_t> winning; /* winning region of player 0 */
+        std::vector<size_t> losing; /* winning region of player 1 */
+        for (const auto& sccs : level_sccs){
+            /* solve the undecided part of every component of this level */
+            std::vector<std::pair<std::vector<size_t>, std::vector<size_t>>> regions(sccs.size());
+            std::vector<Template> strats(sccs.size());
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (size_t k = 0; k < sccs.size(); k++){
+                const auto& vertices = scc_vertices[sccs[k]];
+                VertexSet part(vertices.size());
+                for (size_t l = 0; l < vertices.size(); l++){
+                    if (layer_of[vertices[l]] == Graph::npos){
+                        part.insert(l);
+                    }
+                }
+                if (part.empty()){ /* the component is already decided */
+                    continue;
+                }
+                Graph graph = graph_->induced(vertices, local);
+                ColorMap colors = colors_.empty() ? ColorMap(nullptr, sizeof(size_t), 0)
+                                                  : ColorMap(scc_colors.data() + first[sccs[k]], sizeof(size_t), vertices.size());
+                GameView game(graph, colors, std::move(part), index, first[sccs[k]]);
+                auto result = game.recursive_strategy_template_parity(strats[k]);
+                for (auto l : result.first){
+                    regions[k].first.push_back(vertices[l]);
+                }
+                for (auto l : result.second){
+                    regions[k].second.push_back(vertices[l]);
+                }
+            }
+
+            /* merge the results in the order of the components */
+            std::vector<size_t> win;
+            std::vector<size_t> lose;
+            for (size_t k = 0; k < sccs.size(); k++){
+                win.insert(win.end(), regions[k].first.begin(), regions[k].first.end());
+                lose.insert(lose.end(), regions[k].second.begin(), regions[k].second.end());
+                strat.merge(strats[k]);
+            }
+            if (win.empty() && lose.empty()){
+                continue;
+            }
+            /* attractors of the decided regions in the remaining game */
+            std::sort(win.begin(), win.end());
+            std::sort(lose.begin(), lose.end());
+            auto win_attr = decide_attractor(win, V0, &strat, layer_of, n_layers, remaining);
+            auto lose_attr = decide_attractor(lose, V1, nullptr, layer_of, n_layers, remaining);
+            winning.insert(winning.end(), win_attr.begin(), win_attr.end());
+            losing.insert(losing.end(), lose_attr.begin(), lose_attr.end());
+        }
+        std::pair<VertexSet, VertexSet> result(VertexSet(graph_->n_vert_), VertexSet(graph_->n_vert_));
+        result.first.make_dense();
+        result.second.make_dense();
+        for (auto v : winning){
+            result.first.insert(v);
+        }
+        for (auto v : losing){
+            result.second.insert(v);
+        }
+        return result;
+    }
+
+    /* function: decide_attractor
+     *
+     * attractor of target for player among the undecided vertices of the view, whose vertices are decided
+     * (if strat is given, the attractor of player 0 is computed layer by layer as in find_live_groups_reach,
+     * and the player 0's edges into every layer are added to strat as a live group):
+     * layer_of[v] is the layer in which v is decided (npos if it is undecided), n_layers is the number of
+     * layers so far, and remaining[v] is the number of undecided successors of v */
+    std::vector<size_t> decide_attractor(const std::vector<size_t>& target, const size_t player, Template* strat,
+                                         std::vector<size_t>& layer_of, size_t& n_layers,
+                                         std::vector<size_t>& remaining) const {
+        std::vector<size_t> attracted;
+        std::vector<size_t> layer; /* vertices of the current layer */
+        for (auto v : target){
+            if (vertices_.contains(v) && layer_of[v] == Graph::npos){
+                layer_of[v] = n_layers;
+                layer.push_back(v);
+            }
+        }
+        std::vector<size_t> worklist = layer;
+        while (true){
+            /* vertices attracted by the decided vertices (for live groups: from which no player can avoid them) */
+            while (!worklist.empty()){
+                size_t u = worklist.back();
+                worklist.pop_back();
+                for (auto v : graph_->predecessors(u)){
+                    if (!vertices_.contains(v) || layer_of[v] != Graph::npos){
+                        continue;
+                    }
+                    remaining[v] -= 1;
+                    if ((!strat && owner(v) == player) || remaining[v] == 0){
+                        layer_of[v] = n_layers;
+                        worklist.push_back(v);
+                        layer.push_back(v);
+                    }
+                }
+            }
+            attracted.insert(attracted.end(), layer.begin(), layer.end());
+            if (!strat){
+                break;
+            }
+            /* player 0's edges into the layer */
+            std::set<size_t> sources;
+            for (auto u : layer){
+                for (auto v : graph_->predecessors(u)){
+                    if (vertices_.contains(v) && layer_of[v] == Graph::npos && owner(v) == V0){
+                        sources.insert(v);
+                    }
+                }
+            }
+            if (sources.empty()){
+                break;
+            }
+            EdgeSet live_group;
+            for (auto v : sources){
+                for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1]; i++){
+                    if (layer_of[graph_->succ_[i]] == n_layers){
+                        live_group.push_back(graph_->edge_id(i));
+                    }
+                }
+            }
+            /* the sources start the next layer */
+            n_layers += 1;
+            layer.assign(sources.begin(), sources.end());
+            for (auto v : layer){
+                layer_of[v] = n_layers;
+                worklist.push_back(v);
+            }
+            strat->add_live_group(std::move(live_group));
+        }
+        n_layers += 1;
+        return attracted;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    ///Basic functions
+    ///////////////////////////////////////////////////////////////
+
+    /* function: vertex_with_color
+     *
+     * returns the set of vertices (in a set) with color c */
+    VertexSet vertex_with_color(const size_t c) const {
+        VertexSet result(graph_->n_vert_);
+        if (c >= color_count_.size() || color_count_[c] == 0){
+            return result;
+        }
+        /* only the bucket of c is scanned */
+        for (auto v : index_->bucket(c, index_first_, index_first_ + graph_->n_vert_)){
+            if (vertices_.contains(v - index_first_)){
+                result.insert(v - index_first_);
+            }
+        }
+        return result;
+    }
+
+    /* function: set_complement
+     *
+     * compute complement of a set*/
+    VertexSet set_complement(const VertexSet& set1) const {
+        return vertices_ - set1;
+    }
+
+    /* function: set_union
+     *
+     * compute union of two sets */
+    VertexSet set_union(const VertexSet& set1, const VertexSet& set2) const {
+        return set1 | set2;
+    }
+
+    /* function: edges_between
+     *
+     * return all plyaer 0's edges (inside the view) from source to target */
+    EdgeSet edges_between(const VertexSet& source, const VertexSet& target) const {
+        EdgeSet result_edges;
+        for (auto v : source){
+            if (vertices_.contains(v) && owner(v) == V0){
+                for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1]; i++){
+                    size_t u = graph_->succ_[i];
+                    if (vertices_.contains(u) && target.contains(u)){
+                        result_edges.push_back(graph_->edge_id(i));
+                    }
+                }
+            }
+        }
+        return result_edges;
+    }
+    EdgeSet edges_between(const VertexSet& source,
+                          const VertexSet& target,
+                          VertexSet& new_sources) const {
+        EdgeSet result_edges;
+        for (auto v : source){
+            if (vertices_.contains(v) && owner(v) == V0){
+                for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1]; i++){
+                    size_t u = graph_->succ_[i];
+                    if (vertices_.contains(u) && target.contains(u)){
+                        result_edges.push_back(graph_->edge_id(i));
+                        new_sources.insert(v);
+                    }
+                }
+            }
+        }
+        return result_edges;
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
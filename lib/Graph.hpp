@@ -0,0 +1,350 @@
+/*
+ * Class: Graph
+ *
+ *  Class formalizing the game graph (arena) in compressed sparse row form
+ */
+
+#ifndef GRAPH_HPP_
+#define GRAPH_HPP_
+
+#include <vector>
+#include <span>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <stdexcept>
+
+#include "VertexSet.hpp"
+
+#define V0 0 /* vertices belonging to player 0 */
+#define V1 1 /* vertices belonging to player 1 */
+
+namespace mpa {
+/* class for the game graph: vertices are renumbered densely (0,...,n_vert_-1 in the
+ * order of their original ids) and the successors of all vertices are stored contiguously */
+class Graph {
+public:
+    /* marker for original ids that do not belong to any vertex */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /* number of vertices */
+    size_t n_vert_;
+    /* number of edges */
+    size_t n_edge_;
+    /* original id of every vertex */
+    std::vector<size_t> ids_;
+    /* dense id of every original id (npos if there is no such vertex) */
+    std::vector<size_t> index_;
+    /* owner of every vertex: V0, V1 (or 2 for edge-states of hoa games) */
+    std::vector<uint8_t> owner_;
+    /* successors of vertex v are succ_[succ_begin_[v]],...,succ_[succ_begin_[v+1]-1] (sorted) */
+    std::vector<size_t> succ_begin_;
+    std::vector<size_t> succ_;
+    /* predecessors of vertex v are pred_[pred_begin_[v]],...,pred_[pred_begin_[v+1]-1] (sorted) */
+    std::vector<size_t> pred_begin_;
+    std::vector<size_t> pred_;
+    /* id of the edge succ_[i] is edge_ids_[i]: its position in the graph built by GraphBuilder, which is
+     * kept when the graph is restricted (so ids are increasing along succ_ and sorted ids are grouped by source) */
+    std::vector<size_t> edge_ids_;
+    /* source and target of every edge id (shared by the built graph and all of its restrictions) */
+    std::shared_ptr<const std::vector<std::pair<size_t, size_t>>> edge_ends_;
+public:
+    /* default constructor */
+    Graph() : n_vert_(0), n_edge_(0), succ_begin_(1, 0), pred_begin_(1, 0),
+              edge_ends_(std::make_shared<const std::vector<std::pair<size_t, size_t>>>()) {}
+
+    ///////////////////////////////////////////////////////////////
+    /// Access functions
+    ///////////////////////////////////////////////////////////////
+
+    /* successors of vertex v */
+    std::span<const size_t> successors(const size_t v) const {
+        return std::span<const size_t>(succ_.data() + succ_begin_[v], succ_.data() + succ_begin_[v+1]);
+    }
+
+    /* predecessors of vertex v */
+    std::span<const size_t> predecessors(const size_t v) const {
+        return std::span<const size_t>(pred_.data() + pred_begin_[v], pred_.data() + pred_begin_[v+1]);
+    }
+
+    /* number of successors of vertex v */
+    size_t out_degree(const size_t v) const {
+        return succ_begin_[v+1] - succ_begin_[v];
+    }
+
+    /* number of predecessors of vertex v */
+    size_t in_degree(const size_t v) const {
+        return pred_begin_[v+1] - pred_begin_[v];
+    }
+
+    /* owner of vertex v */
+    size_t owner(const size_t v) const {
+        return owner_[v];
+    }
+
+    /* original id of vertex v */
+    size_t original_id(const size_t v) const {
+        return ids_[v];
+    }
+
+    /* dense id of the vertex with original id (npos if there is no such vertex) */
+    size_t dense_id(const size_t id) const {
+        return id < index_.size() ? index_[id] : npos;
+    }
+
+    /* id of the edge at position i of succ_ */
+    size_t edge_id(const size_t i) const {
+        return edge_ids_[i];
+    }
+
+    /* source of the edge with id e (also for edges removed by restrict) */
+    size_t edge_source(const size_t e) const {
+        return (*edge_ends_)[e].first;
+    }
+
+    /* target of the edge with id e (also for edges removed by restrict) */
+    size_t edge_target(const size_t e) const {
+        return (*edge_ends_)[e].second;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Operators
+    ///////////////////////////////////////////////////////////////
+
+    /* compute the predecessors (backward edges) from the successors */
+    void build_predecessors(){
+        pred_begin_.assign(n_vert_+1, 0);
+        for (auto u : succ_){
+            pred_begin_[u+1] += 1;
+        }
+        for (size_t v = 0; v < n_vert_; v++){
+            pred_begin_[v+1] += pred_begin_[v];
+        }
+        pred_.resize(n_edge_);
+        std::vector<size_t> fill(pred_begin_.begin(), pred_begin_.end()-1);
+        for (size_t v = 0; v < n_vert_; v++){
+            for (auto u : successors(v)){
+                pred_[fill[u]++] = v;
+            }
+        }
+    }
+
+    /* sort the successors of every vertex and remove duplicate edges (the rows are given by succ_begin_
+     * and succ_), then compute the predecessors and number the edges by their positions */
+    void finish_rows(){
+        std::vector<size_t> row_end(n_vert_); /* end of every row without duplicates */
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (size_t v = 0; v < n_vert_; v++){
+            auto first = succ_.begin() + succ_begin_[v];
+            auto last = succ_.begin() + succ_begin_[v+1];
+            std::sort(first, last);
+            row_end[v] = std::unique(first, last) - succ_.begin();
+        }
+        size_t n_edge = 0;
+        for (size_t v = 0; v < n_vert_; v++){
+            auto first = succ_.begin() + succ_begin_[v];
+            succ_begin_[v] = n_edge;
+            n_edge = std::copy(first, succ_.begin() + row_end[v], succ_.begin() + n_edge) - succ_.begin();
+        }
+        succ_begin_[n_vert_] = n_edge;
+        succ_.resize(n_edge);
+        n_edge_ = n_edge;
+        build_predecessors();
+        /* the edges are numbered by their positions */
+        edge_ids_.resize(n_edge);
+        std::iota(edge_ids_.begin(), edge_ids_.end(), 0);
+        auto edge_ends = std::make_shared<std::vector<std::pair<size_t, size_t>>>(n_edge);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (size_t v = 0; v < n_vert_; v++){
+            for (size_t i = succ_begin_[v]; i < succ_begin_[v+1]; i++){
+                (*edge_ends)[i] = std::make_pair(v, succ_[i]);
+            }
+        }
+        edge_ends_ = std::move(edge_ends);
+    }
+
+    /* strongly connected components of the subgraph induced by the vertices in keep:
+     * component[v] is the component of v (npos for the other vertices) and the components are
+     * numbered in reverse topological order, i.e. edges only lead to components with smaller or equal numbers;
+     * returns the number of components */
+    size_t strongly_connected_components(const VertexSet& keep, std::vector<size_t>& component) const {
+        component.assign(n_vert_, npos);
+        std::vector<size_t> index(n_vert_, npos); /* discovery index of the vertices */
+        std::vector<size_t> low(n_vert_, 0); /* smallest index reachable via the dfs subtree */
+        std::vector<bool> on_stack(n_vert_, false);
+        std::vector<size_t> stack; /* vertices of the components not completed yet */
+        std::vector<std::pair<size_t, size_t>> dfs; /* dfs path: vertex and position of the next successor */
+        size_t counter = 0;
+        size_t n_comp = 0;
+        for (auto root : keep){
+            if (index[root] != npos){
+                continue;
+            }
+            index[root] = low[root] = counter++;
+            stack.push_back(root);
+            on_stack[root] = true;
+            dfs.push_back(std::make_pair(root, succ_begin_[root]));
+            while (!dfs.empty()){
+                size_t v = dfs.back().first;
+                size_t& pos = dfs.back().second;
+                if (pos < succ_begin_[v+1]){
+                    size_t u = succ_[pos++];
+                    if (!keep.contains(u)){
+                        continue;
+                    }
+                    if (index[u] == npos){
+                        index[u] = low[u] = counter++;
+                        stack.push_back(u);
+                        on_stack[u] = true;
+                        dfs.push_back(std::make_pair(u, succ_begin_[u]));
+                    }
+                    else if (on_stack[u]){
+                        low[v] = std::min(low[v], index[u]);
+                    }
+                    continue;
+                }
+                dfs.pop_back();
+                if (low[v] == index[v]){ /* v is the root of a component */
+                    size_t u;
+                    do {
+                        u = stack.back();
+                        stack.pop_back();
+                        on_stack[u] = false;
+                        component[u] = n_comp;
+                    } while (u != v);
+                    n_comp += 1;
+                }
+                if (!dfs.empty()){
+                    size_t parent = dfs.back().first;
+                    low[parent] = std::min(low[parent], low[v]);
+                }
+            }
+        }
+        return n_comp;
+    }
+
+    /* graph with the same vertices but only the edges between vertices in keep */
+    Graph restrict(const std::vector<bool>& keep) const {
+        Graph graph;
+        graph.n_vert_ = n_vert_;
+        graph.ids_ = ids_;
+        graph.index_ = index_;
+        graph.owner_ = owner_;
+        graph.edge_ends_ = edge_ends_;
+        graph.succ_begin_.assign(n_vert_+1, 0);
+        graph.succ_.reserve(n_edge_);
+        graph.edge_ids_.reserve(n_edge_);
+        for (size_t v = 0; v < n_vert_; v++){
+            if (keep[v]){
+                for (size_t i = succ_begin_[v]; i < succ_begin_[v+1]; i++){
+                    if (keep[succ_[i]]){
+                        graph.succ_.push_back(succ_[i]);
+                        graph.edge_ids_.push_back(edge_ids_[i]);
+                    }
+                }
+            }
+            graph.succ_begin_[v+1] = graph.succ_.size();
+        }
+        graph.n_edge_ = graph.succ_.size();
+        graph.build_predecessors();
+        return graph;
+    }
+
+    /* subgraph induced by the given vertices (increasing), renumbered 0,...,k-1 in their order, where local[v] is
+     * the position of v in vertices for the given vertices (and arbitrary for the others): the original ids of
+     * the subgraph are the ids of its vertices in this graph, and the edge ids (and their ends) are kept */
+    Graph induced(const std::vector<size_t>& vertices, const std::vector<size_t>& local) const {
+        Graph graph;
+        graph.n_vert_ = vertices.size();
+        graph.ids_ = vertices;
+        graph.edge_ends_ = edge_ends_;
+        graph.owner_.resize(graph.n_vert_);
+        graph.succ_begin_.assign(graph.n_vert_+1, 0);
+        for (size_t l = 0; l < graph.n_vert_; l++){
+            size_t v = vertices[l];
+            graph.owner_[l] = owner_[v];
+            for (size_t i = succ_begin_[v]; i < succ_begin_[v+1]; i++){
+                size_t u = local[succ_[i]];
+                if (u < graph.n_vert_ && vertices[u] == succ_[i]){
+                    graph.succ_.push_back(u);
+                    graph.edge_ids_.push_back(edge_ids_[i]);
+                }
+            }
+            graph.succ_begin_[l+1] = graph.succ_.size();
+        }
+        graph.n_edge_ = graph.succ_.size();
+        graph.build_predecessors();
+        return graph;
+    }
+}; /* close class definition */
+
+/* class for constructing a graph from vertices and edges given by their original ids */
+class GraphBuilder {
+public:
+    /* vertices as pairs (original id, owner) */
+    std::vector<std::pair<size_t, size_t>> vertices_;
+    /* edges as pairs (original id of source, original id of target) */
+    std::vector<std::pair<size_t, size_t>> edges_;
+public:
+    /* default constructor */
+    GraphBuilder() {}
+
+    /* add a vertex (the owner of a vertex added twice is overwritten) */
+    void add_vertex(const size_t id, const size_t owner){
+        vertices_.push_back(std::make_pair(id, owner));
+    }
+
+    /* add an edge (duplicate edges are merged) */
+    void add_edge(const size_t source, const size_t target){
+        edges_.push_back(std::make_pair(source, target));
+    }
+
+    /* construct the graph */
+    Graph build() const {
+        Graph graph;
+        size_t max_id = 0;
+        for (const auto& vertex : vertices_){
+            max_id = std::max(max_id, vertex.first);
+        }
+        /* owner of every original id (npos for unused ids) */
+        std::vector<size_t> owners(vertices_.empty() ? 0 : max_id+1, Graph::npos);
+        for (const auto& vertex : vertices_){
+            owners[vertex.first] = vertex.second;
+        }
+        /* renumber the vertices in the order of their original ids */
+        graph.index_.assign(owners.size(), Graph::npos);
+        for (size_t id = 0; id < owners.size(); id++){
+            if (owners[id] != Graph::npos){
+                graph.index_[id] = graph.ids_.size();
+                graph.ids_.push_back(id);
+                graph.owner_.push_back(owners[id]);
+            }
+        }
+        graph.n_vert_ = graph.ids_.size();
+
+        /* count the successors of every vertex and place them in their rows */
+        graph.succ_begin_.assign(graph.n_vert_+1, 0);
+        for (const auto& edge : edges_){
+            if (graph.dense_id(edge.first) == Graph::npos || graph.dense_id(edge.second) == Graph::npos){
+                throw std::runtime_error("Error: edge (" + std::to_string(edge.first) + ", " + std::to_string(edge.second) + ") uses an undeclared vertex.");
+            }
+            graph.succ_begin_[graph.index_[edge.first]+1] += 1;
+        }
+        for (size_t v = 0; v < graph.n_vert_; v++){
+            graph.succ_begin_[v+1] += graph.succ_begin_[v];
+        }
+        std::vector<size_t> fill(graph.succ_begin_.begin(), graph.succ_begin_.end()-1);
+        graph.succ_.resize(edges_.size());
+        for (const auto& edge : edges_){
+            graph.succ_[fill[graph.index_[edge.first]]++] = graph.index_[edge.second];
+        }
+        graph.finish_rows();
+        return graph;
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
@@ -8,6 +8,10 @@
 #define MULTIGAME_HPP_
 
 #include "Game.hpp"
+#include "ConflictIndex.hpp"
+#include "ColorMatrix.hpp"
+#include "Solver.hpp"
+#include "SlicedGame.hpp"
 #include <random>
 
 // #include "FileHandler.hpp"
@@ -18,8 +22,12 @@ class MultiGame: public Game {
 public:
     /* all maximum of colors */
     std::vector<size_t> all_max_color_;
-    /* all_colors: the i-th vector represents i-th color set (for i=1,2)*/
-    std::vector<std::map<size_t, size_t>> all_colors_;
+    /* all_colors: the i-th column represents i-th color set (for i=1,2), indexed by dense ids
+     * (not stored if the i-th objective is a threshold view of colors_) */
+    ColorMatrix all_colors_;
+    /* thresholds: the i-th objective whose column is not stored has the colors of colors_ with odd color
+     * thresholds_[i] (see ColorMap), which are computed on the fly */
+    std::vector<size_t> thresholds_;
     /* number of objectives (0th one for player 0, rest for player 1)*/
     size_t n_games_;
     
@@ -28,14 +36,14 @@ public:
     MultiGame(): Game() {
         n_games_ = 2;
         all_max_color_ = std::vector<size_t>(2,0);
-        all_colors_ = std::vector<std::map<size_t, size_t>>(2,std::map<size_t, size_t>());
+        all_colors_ = ColorMatrix(0, 2);
     }
 
     /* copy a normal game */
     MultiGame(const Game other): Game(other){
         n_games_ = 1;
         all_max_color_.push_back(max_color_);
-        all_colors_.push_back(colors_);
+        all_colors_.add_column(colors_);
     }
 
     ///////////////////////////////////////////////////////////////
@@ -48,11 +56,10 @@ public:
             n_vert_ = newGame.n_vert_;
             n_edge_ = newGame.n_edge_;
             vertices_ = newGame.vertices_;
-            edges_ = newGame.edges_;
-            vert_id_ = newGame.vert_id_;
+            graph_ = newGame.graph_;
             max_color_ = newGame.max_color_;
             n_games_ = 1;
-            all_colors_.push_back(newGame.colors_);
+            all_colors_.add_column(newGame.colors_);
             all_max_color_.push_back(max_color_);
             colors_ = newGame.colors_;
         }
@@ -62,7 +69,7 @@ public:
             //     std::cerr << "[ERROR] mergeGame: The game graph of the new game is different.\n";
             n_games_ += 1; /* number of games is increased by one */
             max_color_ = std::max(max_color_, newGame.max_color_); /* max_color is updated */
-            all_colors_.push_back(newGame.colors_); /* colors is added to all_colors vector */
+            all_colors_.add_column(newGame.colors_); /* colors is added to all_colors matrix */
             all_max_color_.push_back(newGame.max_color_); /* max_color is added to all_max_color vector */
         }
     }
@@ -74,24 +81,69 @@ public:
         game.n_edge_ = n_edge_;
         game.vertices_ = vertices_;
         game.init_vert_ = init_vert_;
-        game.vert_id_ = vert_id_;
-        game.edges_ = edges_;
-        game.colors_ = all_colors_[n];
+        game.graph_ = graph_;
+        game.colors_ = objective_colors(n).to_vector();
         game.max_color_ = max_col(game.colors_);
         return game;
     }
 
+    /* colors of the n-th game */
+    ColorMap objective_colors(const size_t n) const{
+        if (!all_colors_.stored(n) && n < thresholds_.size()){
+            return ColorMap(colors_, thresholds_[n]);
+        }
+        return all_colors_.column(n);
+    }
+
+    /* color of vertex v in the n-th game */
+    size_t color(const size_t n, const size_t v) const{
+        return objective_colors(n)[v];
+    }
+
+    /* view of the n-th game: the graph is shared and only the n-th colors are selected */
+    GameView objective(const size_t n) const{
+        return GameView(graph_, objective_colors(n), vertex_set(vertices_));
+    }
+
+    /* compute the template of the n-th game (bottom-up along the SCCs of the game if scc is true, otherwise
+     * with the solver specialized for its maximum color) */
+    std::pair<VertexSet, VertexSet> objective_template(const size_t n, Template& strat, const bool scc = false) const{
+        GameView game = objective(n);
+        return scc ? game.scc_strategy_template_parity(strat) : solve_parity(game, &strat);
+    }
+
+    /* compute the templates of all games together by SlicedGame, 64 at a time (the same templates as
+     * objective_template without scc): the template of the i-th game is added to strats[i], and the losing
+     * regions of the games are returned */
+    std::vector<VertexSet> sliced_objective_templates(std::vector<Template>& strats) const{
+        std::vector<VertexSet> losing_regions(n_games_);
+        VertexSet vertices = vertex_set(vertices_);
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t first = 0; first < n_games_; first += 64){
+            size_t last = std::min(first+64, n_games_);
+            std::vector<ColorMap> colors;
+            for (size_t i = first; i < last; i++){
+                colors.push_back(objective_colors(i));
+            }
+            auto losing = SlicedGame(graph_, colors).solve(vertices, std::span<Template>(strats).subspan(first, last-first));
+            for (size_t k = 0; k < losing.size(); k++){
+                losing_regions[first+k] = std::move(losing[k]);
+            }
+        }
+        return losing_regions;
+    }
+
     /* replace the multigame */
     void copy(const MultiGame& other){
         n_vert_ = other.n_vert_;
         n_edge_ = other.n_edge_;
         vertices_ = other.vertices_;
-        edges_ = other.edges_;
-        vert_id_ = other.vert_id_;
+        graph_ = other.graph_;
         max_color_ = other.max_color_;
         colors_ = other.colors_;
         n_games_ = other.n_games_;
         all_colors_ = other.all_colors_;
+        thresholds_ = other.thresholds_;
         all_max_color_ = other.all_max_color_;
     }
 
@@ -107,8 +159,8 @@ public:
 
         std::map<std::pair<size_t,size_t>,size_t> product_verts; /* map of product of vertices to new vertieces */
 
-        /* if one game is empty then return empty */
-        if (game1.n_vert_ == 0 || game2.n_vert_ == 0){
+        /* if one game is empty (or has no initial vertex) then return empty */
+        if (game1.n_vert_ == 0 || game2.n_vert_ == 0 || game1.init_vert_ == Graph::npos || game2.init_vert_ == Graph::npos){
             return 1;
         }
         /* update the aps : ids of aps in all 3 games */
@@ -154,18 +206,19 @@ public:
         
 
         /* initial vertex should be of same player in both games */
-        if (game1.vert_id_.at(game1.init_vert_) != game2.vert_id_.at(game2.init_vert_)){
+        if (game1.owner(game1.init_vert_) != game2.owner(game2.init_vert_)){
             std::cerr << "Error: vertex ids of both games are not same!\n";
         }
+        /* the product is collected with its own vertex ids and converted to the graph at the end */
+        GraphBuilder builder; /* vertices and edges of the product */
+        std::vector<std::map<size_t, size_t>> product_colors(2); /* colors of the product vertices */
+        std::map<size_t, EdgeLabel> product_labels; /* labels of the product edge-vertices */
         /* insert initial vertex and update all variables */
-        n_vert_ = 1;
         size_t org_vert = 1; /* counter for normal vertices */
         size_t edge_vert = (game1.n_vert_-game1.n_edge_/2)*(game2.n_vert_-game2.n_edge_/2); /* counter for edge-vertices */
-        vertices_.insert(0); 
-        init_vert_ = 0;
-        vert_id_[0] = game1.vert_id_.at(game1.init_vert_);
-        all_colors_[0][0] = game1.colors_.at(game1.init_vert_);
-        all_colors_[1][0] = game2.colors_.at(game2.init_vert_);
+        builder.add_vertex(0, game1.owner(game1.init_vert_));
+        product_colors[0][0] = game1.colors_.at(game1.init_vert_);
+        product_colors[1][0] = game2.colors_.at(game2.init_vert_);
         product_verts.insert({std::make_pair(game1.init_vert_,game2.init_vert_),0});
 
         /* maintain a stack to explore new (product) vertices */
@@ -177,30 +230,32 @@ public:
         while (!stack_list.empty()){
             std::vector<size_t> curr = stack_list.top(); /* current pair of vertices */
             stack_list.pop(); /* pop the top element from stack list */
-            for (auto u : game1.edges_.at(curr[1])){ /* for each edge-neighbour of 1st vertex */
-                for (auto v : game2.edges_.at(curr[2])){ /* for each edge-neihbour of 2nd vertex */
+            for (auto u : game1.successors(curr[1])){ /* for each edge-neighbour of 1st vertex */
+                for (auto v : game2.successors(curr[2])){ /* for each edge-neihbour of 2nd vertex */
                     bool valid = true; /* if product of these two edges is possible */
-                    std::vector<size_t> temp_common(ap_id_.size(),2); /* needed if possible, temporarily store the ids of this new edge */
+                    EdgeLabel temp_common(ap_id_.size()); /* needed if possible, temporarily store the label of this new edge */
                     for (auto ap : common_aps){ /* first go through common aps */
-                        if (game1.labels_.at(u)[ap[1]]+game2.labels_.at(v)[ap[2]] == 1){
+                        size_t literal1 = game1.labels_.get(u, ap[1]);
+                        size_t literal2 = game2.labels_.get(v, ap[2]);
+                        if (literal1+literal2 == 1){
                             valid = false; /* one of the id of this ap is 1 and other is 0, so not valid product */
                             break;
                         }
                         /* if this ap is consistent in both edges then add its label to temp_common */
-                        else if (game1.labels_.at(u)[ap[1]] == 0 || game2.labels_.at(v)[ap[2]] == 0){
-                            temp_common[ap[0]] = 0;
+                        else if (literal1 == NEG || literal2 == NEG){
+                            temp_common.set(ap[0], NEG);
                         }
-                        else if (game1.labels_.at(u)[ap[1]] == 1 || game2.labels_.at(v)[ap[2]] == 1){
-                            temp_common[ap[0]] = 1;
+                        else if (literal1 == POS || literal2 == POS){
+                            temp_common.set(ap[0], POS);
                         }
                     }
                     if (valid){ /* if the product-edge is valid */
                         /* update its temp_common to all ids */
                         for (auto ap : first_aps){
-                            temp_common[ap[0]] = game1.labels_.at(u)[ap[1]];
+                            temp_common.set(ap[0], game1.labels_.get(u, ap[1]));
                         }
                         for (auto ap : second_aps){
-                            temp_common[ap[0]] = game2.labels_.at(v)[ap[1]];
+                            temp_common.set(ap[0], game2.labels_.get(v, ap[1]));
                         }
                         size_t newId = org_vert; 
                         if (hoa){
@@ -211,32 +266,25 @@ public:
                             org_vert += 1;
                         }
                         /* update all variables for new game */
-                        n_vert_ += 1;
-                        n_edge_ += 2;
-                        vertices_.insert(newId);
-                        vert_id_[newId] = 2;
-                        edges_[curr[0]].insert(newId);
-                        labels_[newId] = temp_common;
-                        all_colors_[0][newId] = game1.colors_.at(u);
-                        all_colors_[1][newId] = game2.colors_.at(v);
+                        builder.add_vertex(newId, 2);
+                        builder.add_edge(curr[0], newId);
+                        product_labels[newId] = std::move(temp_common);
+                        product_colors[0][newId] = game1.colors_.at(u);
+                        product_colors[1][newId] = game2.colors_.at(v);
 
                         /* product of end-states of these edges */
-                        std::pair<size_t,size_t> new_succ = std::make_pair(*game1.edges_.at(u).begin(),*game2.edges_.at(v).begin());
+                        std::pair<size_t,size_t> new_succ = std::make_pair(game1.successors(u)[0],game2.successors(v)[0]);
                         if (product_verts.find(new_succ) != product_verts.end()){ /* if the product of end-states of edges are already present add the edge */
-                            edges_[newId].insert(product_verts.at(new_succ));
-                            pre_edges_[product_verts.at(new_succ)].insert(newId);
+                            builder.add_edge(newId, product_verts.at(new_succ));
                         }
                         else{ /* if the product of end-states of edges are not present */
                             size_t succId = org_vert; /* new state for the product-successor-states : use org_vert counter */
                             /* update all variables in the new game */
                             org_vert += 1;
-                            n_vert_ += 1;
-                            vertices_.insert(succId);
-                            vert_id_[succId] = game1.vert_id_.at(new_succ.first);
-                            edges_[newId].insert(succId);
-                            pre_edges_[succId].insert(newId);
-                            all_colors_[0][succId] = game1.colors_.at(new_succ.first);
-                            all_colors_[1][succId] = game2.colors_.at(new_succ.second);
+                            builder.add_vertex(succId, game1.owner(new_succ.first));
+                            builder.add_edge(newId, succId);
+                            product_colors[0][succId] = game1.colors_.at(new_succ.first);
+                            product_colors[1][succId] = game2.colors_.at(new_succ.second);
                             product_verts[new_succ] = succId;
                             stack_list.push(std::vector<size_t>{succId,new_succ.first,new_succ.second});
                         }
@@ -244,9 +292,22 @@ public:
                 }
             }
         }
+        /* construct the graph and move everything to the dense ids */
+        set_graph(builder.build());
+        init_vert_ = graph_.dense_id(0);
+        all_colors_ = ColorMatrix(graph_.n_vert_, 2);
+        for (size_t i = 0; i < 2; i++){
+            for (const auto& pair : product_colors[i]){
+                all_colors_.set(i, graph_.dense_id(pair.first), pair.second);
+            }
+        }
+        labels_ = EdgeLabels(product_labels.empty() ? 0 : graph_.n_vert_, ap_id_.size());
+        for (const auto& pair : product_labels){
+            labels_.set(graph_.dense_id(pair.first), pair.second);
+        }
         /* update max_color */
-        all_max_color_[0] = max_col(all_colors_[0]); 
-        all_max_color_[1] = max_col(all_colors_[1]); 
+        all_max_color_[0] = max_col(all_colors_.column(0)); 
+        all_max_color_[1] = max_col(all_colors_.column(1)); 
         return 1;
     }
 
@@ -259,6 +320,7 @@ public:
     void randMultigame(const size_t n_games, const size_t max_col, const bool clear = true){
         if (clear){/* remove all previous colors if clear is true */
             all_colors_.clear();
+            thresholds_.clear();
             n_games_ = 0;
         }
         /* update number of games */
@@ -267,13 +329,13 @@ public:
         max_color_ = max_col;
         /* add n_games set of random colors */
         for (size_t i = 0; i < n_games; i++){
-            all_colors_.push_back(random_colors(max_col));
+            all_colors_.add_column(random_colors(max_col));
         }
     }
 
     /* generate a set of random colors <= max_col */
-    std::map<size_t, size_t> random_colors(const size_t max_col){
-        std::map<size_t, size_t> colors;
+    std::vector<size_t> random_colors(const size_t max_col){
+        std::vector<size_t> colors(graph_.n_vert_, 0);
         
         /* a vector of all vertices */
         std::vector<size_t> vertices(vertices_.begin(), vertices_.end());
@@ -288,7 +350,7 @@ public:
                 size_t rand_index = random_num(remaining_num); /* generate random index */
                 size_t vertex = remaining_vert[rand_index]; /* vertex at rand_index in remaining vertices */
                 
-                colors.insert(std::make_pair(vertex, col)); /* set color of that vertex as col */
+                colors[vertex] = col; /* set color of that vertex as col */
                 remaining_vert.erase(remaining_vert.begin() + rand_index); /* remove that vertex from remaining vertices */
                 remaining_num -= 1; /* update remaining number of vertices */
             }
@@ -296,7 +358,7 @@ public:
         /* randomly choose color for remaining vertices */
         for (auto vertex : remaining_vert){
             size_t rand_col = random_num(max_col); /* generate random color */
-            colors.insert(std::make_pair(vertex, rand_col)); /* set color of vertex to rand_col */
+            colors[vertex] = rand_col; /* set color of vertex to rand_col */
         }
         return colors;
     }
@@ -315,54 +377,75 @@ public:
     ///Compose templates of multiple games
     ///////////////////////////////////////////////////////////////
     
-    /* compute the composition of permissive strategy template for two games */
-    std::pair<std::set<size_t>, std::set<size_t>> find_composition_template(Template& strat) const {
+    /* compute the composition of permissive strategy template for two games
+     * (with scc = true, the games are solved bottom-up along the SCCs of the game graph;
+     * with sliced = true and scc = false, the templates of all games are computed together) */
+    std::pair<std::set<size_t>, std::set<size_t>> find_composition_template(Template& strat, const bool scc = false, const bool sliced = false) const {
         /* clear the template */
         strat.clear();
 
         /* solve the games without changing anything in the original game */
         MultiGame multigame_copy(*this); /* copy of the multi-game */
-        auto winning_region = multigame_copy.recursive_composition_template(strat);
+        auto winning_region = multigame_copy.recursive_composition_template(strat, scc, sliced);
         /* unsafe edges are the player 0's edges from winning region to losing region */
         strat.unsafe_edges_ = edges_between(winning_region.first, set_complement(winning_region.first));
         /* return winning region */
         return winning_region;
     }
 
-    /* recursively compute the composition of strategy template for two games */
-    std::pair<std::set<size_t>, std::set<size_t>> recursive_composition_template(Template& strat) {
+    /* recursively compute the composition of strategy template for two games
+     *
+     * in the sliced mode, the templates of the games are computed by one bit-sliced zielonka's algorithm for
+     * every 64 games (the same templates as the solvers of the games one by one) */
+    std::pair<std::set<size_t>, std::set<size_t>> recursive_composition_template(Template& strat, const bool scc = false, const bool sliced = false) {
         auto winning_region = std::make_pair(vertices_, std::set<size_t> {}); /* winning region of the games */
-        std::vector<std::set<size_t>> losing_regions(n_games_); /* losing region of i-th game */
+        std::vector<VertexSet> losing_regions(n_games_); /* losing region of i-th game */
         std::vector<Template> i_templates(n_games_); /* templates of i-th game */
         std::set<size_t> colive_vertices; /* vertices with color 2d+1 */
         // size_t counter = 0; /* count thenumber of iteration */
         
         if (n_games_ == 1){ /* if there is only one game, solve in standard way */
-            Game game = nthGame(0);
-            winning_region =  game.recursive_strategy_template_parity(strat);
+            winning_region = to_sets(objective_template(0, strat, scc));
             return winning_region; /* return winning region */
         }
 
         while (true){/* iterate until there is no need to solve any game again */
             // /* print to analyze the results */
             // std::cout << "couter begins:"<<counter<< "  colive:"<<colive_vertices.size()<<"  winning:"<<winning_region.first.size()<<"\n"; 
-            /* compute template for every game */
-            #pragma omp parallel
-            #pragma omp for 
+            /* set color of all colive vertices to the minimum odd color >= max color of every game */
             for (size_t i = 0; i < n_games_; i++){
-                size_t colive_color = max_odd(all_colors_[i]); /* minimum odd color >= max color */
-                for (const size_t v : colive_vertices){/* set color of all colive vertices colive_color */
-                    all_colors_[i].at(v) = colive_color;
+                if (!all_colors_.stored(i) && !colive_vertices.empty()){
+                    /* a threshold view is only stored when it is recolored */
+                    all_colors_.store(i, objective_colors(i).to_vector());
+                }
+                size_t colive_color = max_odd(objective_colors(i));
+                for (const size_t v : colive_vertices){
+                    all_colors_.set(i, v, colive_color);
+                }
+            }
+            if (sliced && !scc){
+                /* compute template and winning region of all games together */
+                losing_regions = sliced_objective_templates(i_templates);
+            }
+            else {
+                /* compute template for every game (in parallel: the games only read the multigame and every
+                 * thread writes its own losing region and template, which are merged in the order of the games) */
+                #pragma omp parallel for schedule(dynamic, 1)
+                for (size_t i = 0; i < n_games_; i++){
+                    /* compute template and winning region of i-th game (on a view sharing the game graph) */
+                    losing_regions[i] = objective_template(i, i_templates[i], scc).second;
                 }
-                mpa::Game game = nthGame(i); /* i-th game */
-                
-                /* compute template and winning region of i-th game */
-                losing_regions[i] = nthGame(i).recursive_strategy_template_parity(i_templates[i]).second;
             }
             
             /* compute the overall winning region */
-            winning_region.second = nthGame(0).solve_reachability_game(set_union(losing_regions),{}).first; 
-            winning_region.first = set_complement(winning_region.second);
+            VertexSet losing_region(graph_.n_vert_);
+            for (const auto& region : losing_regions){
+                losing_region |= region;
+            }
+            VertexSet losing = view().solve_reachability_game(losing_region,{}).first;
+            VertexSet winning = vertex_set(vertices_) - losing;
+            winning_region.second = losing.to_set();
+            winning_region.first = winning.to_set();
 
             /* merge all templates */
             strat.merge_live_colive(i_templates);
@@ -370,14 +453,20 @@ public:
             /* clear the colive vertices for new iteration */
             colive_vertices.clear(); 
             
-            /* compute conflicts by colive edges (containing all outgoing edges of a vertex) */
-            conflict_colive(strat.colive_edges_, winning_region, colive_vertices);
-            /* compute conflicts by colive edges and live groups */
-            conflict_live_colive(strat.live_groups_, strat.colive_edges_, winning_region, colive_vertices);
+            /* compute conflicts by colive edges (containing all outgoing edges of a vertex, or all edges
+             * of a vertex in a live group) on the template indexed by the sources of its edges;
+             * the colive vertices are all in the winning region */
+            bool unsafe_conflict = false;
+            {
+                ConflictIndex index(graph_, strat);
+                index.colive_conflicts(winning, colive_vertices);
+                /* check for conflicts by unsafe edges only if there is no conflicts by live groups and colive edges
+                 * (before the losing region is removed from the graph) */
+                unsafe_conflict = colive_vertices.empty() && index.unsafe_conflict(winning, losing);
+            }
 
             /* first remove losing region from everywhere */
             remove_vertices(winning_region.second);
-            colive_vertices = set_difference(colive_vertices, winning_region.second);
                 
             
             /* print to analyze the results */
@@ -390,14 +479,15 @@ public:
             /* check if there is no conflicts by live groups and colive edges */
             if (colive_vertices.empty()){/* if no conflicts by live colive edges, then check conflict by unsafe edges */
                 /* check if there is no conflicts by unsafe edges */
-                if (!conflict_unsafe(strat.live_groups_, strat.colive_edges_, winning_region)){
+                if (!unsafe_conflict){
                     /* remove the unsafe edges and edges from losing region from colive edge set */
-                    map_remove_vertices(strat.colive_edges_, winning_region.second);
+                    edges_remove_vertices(strat.colive_edges_, winning_region.second);
                     /* remove the restrictions on losing regions and colive edges from live group (as there is other choice from that source) */
-                    for (auto& live_group : strat.live_groups_){
-                        map_remove_keys(live_group, winning_region.second);
-                        map_remove(live_group, strat.colive_edges_);
-                    }
+                    strat.transform_live_groups([&](EdgeSet live_group){
+                        edges_remove_sources(live_group, winning_region.second);
+                        strat.edge_remove(live_group, strat.colive_edges_);
+                        return live_group;
+                    });
                     break; /* break the loop as there is no more conflict */
                 }
             }
@@ -413,55 +503,53 @@ public:
         return winning_region; /* return winning region */
     }
     
-    /* Check if the unsafe edges create some conflict */
-    bool conflict_unsafe(std::vector<std::map<size_t, std::set<size_t>>>& live_group_set,
-                            std::map<size_t, std::set<size_t>>& colive_edge_set,
-                            const std::pair<std::set<size_t>, std::set<size_t>>& winning_region) {
-        for (auto v : winning_region.first){
-            if (!edges_.at(v).empty() && check_set_inclusion(edges_.at(v), set_union(winning_region.second, colive_edge_set[v]))){
-                return true; /* return true if there is a conflict */
-            }
-        }                
-        for (auto& live_group : live_group_set){ /* iterate over all live groups to compute live_unsafe_region */
-            for (auto v : winning_region.first){
-            if (!live_group[v].empty() &&  check_set_inclusion(live_group[v], set_union(winning_region.second, colive_edge_set[v]))){
-                    return true; /* return true if there is a conflict */
-                }
-            }
-        }
-        return false; /* return false if there is no conflict (no dead-ends) */
-    }
+    ///////////////////////////////////////////////////////////////
+    ///Priority compression
+    ///////////////////////////////////////////////////////////////
 
-    /* check conflict when the union of all colive edge set contains all edges of some vertex */
-    void conflict_colive(const std::map<size_t, std::set<size_t>>& colive_edge_set,
-                        const std::pair<std::set<size_t>, std::set<size_t>>& winning_region,
-                        std::set<size_t>& colive_vertices) {
-        for (auto it = colive_edge_set.begin(); it != colive_edge_set.end(); it++){
-            auto v = it ->first;
-            if (winning_region.first.find(v)!= winning_region.first.end() && !edges_.at(v).empty() && check_set_inclusion(edges_.at(v), it->second)){
-                /* if all edges of a source is colive then add the source to colive vertices */
-                colive_vertices.insert(v);
-            }
-        }      
+    /* compress the colors of every objective without changing its template: the solvers only depend on the
+     * order and the parity of the colors of a game, so the colors that no vertex has are left out
+     * output: total number of colors (of all objectives) before and after the compression */
+    std::pair<size_t, size_t> compress_priorities(){
+        std::pair<size_t, size_t> n_colors(0, 0);
+        max_color_ = 0;
+        all_max_color_.assign(n_games_, 0);
+        for (size_t i = 0; i < n_games_; i++){
+            std::vector<size_t> colors = objective_colors(i).to_vector();
+            n_colors.first += max_col(colors)+1;
+            all_colors_.store(i, compress_colors(colors));
+            all_max_color_[i] = max_col(all_colors_.column(i));
+            max_color_ = std::max(max_color_, all_max_color_[i]);
+            n_colors.second += all_max_color_[i]+1;
+        }
+        return n_colors;
     }
 
-    /* solve the conflict when the intersection of colive edges and live groups is non-empty */
-    void conflict_live_colive(std::vector<std::map<size_t, std::set<size_t>>>& live_group_set,
-                                const std::map<size_t, std::set<size_t>>& colive_edge_set,
-                                const std::pair<std::set<size_t>, std::set<size_t>>& winning_region,
-                                std::set<size_t>& colive_vertices) {
-        std::set<size_t> conflict_keys; /* sources of the possible conflict edges */
-        for (auto& live_group : live_group_set){ /* iterate over all live groups */
-            for (auto it = colive_edge_set.begin(); it != colive_edge_set.end(); it++){
-            auto v = it ->first;
-            if (winning_region.first.find(v)!= winning_region.first.end() && !live_group[v].empty() && check_set_inclusion(live_group[v], it->second)){
-                    /* for any conflict source, if there is no other choice in the live group
-                    then there is a conflict */
-                    /* if there is conflict then add the source to colive vertices */
-                    colive_vertices.insert(v);
-                }
+    /* compress colors keeping their order and parity: the colors of the vertices are renumbered in increasing
+     * order, each one to the smallest color of its parity above the previous one (the smallest one becomes 0
+     * if it is even and 1 otherwise); two colors are never merged, as the template of a game depends on the
+     * vertices of every color (e.g. on the targets of the live groups) */
+    std::vector<size_t> compress_colors(const std::vector<size_t>& colors) const {
+        std::vector<size_t> new_colors = colors;
+        std::set<size_t> used_colors; /* colors of the vertices in increasing order */
+        for (auto v : vertices_){
+            used_colors.insert(colors[v]);
+        }
+        if (used_colors.empty()){
+            return new_colors;
+        }
+        std::vector<size_t> color_map(*used_colors.rbegin()+1, 0); /* old color to new color */
+        size_t new_col = *used_colors.begin() % 2;
+        for (auto c : used_colors){
+            if (c != *used_colors.begin()){
+                new_col += (c % 2 != new_col % 2) ? 1 : 2; /* next color with the parity of c */
             }
+            color_map[c] = new_col;
         }
+        for (auto v : vertices_){
+            new_colors[v] = color_map[colors[v]];
+        }
+        return new_colors;
     }
 
 
@@ -469,7 +557,9 @@ public:
     ///Solve parity games using multiple {0,1,2,3}-parity games
     ///////////////////////////////////////////////////////////////
 
-    /* convert the parity game to multiple small games */
+    /* convert the parity game to multiple small games: the game of odd color odd_col has color 0 for the
+     * vertices with color < odd_col, 2 for the vertices with even color > odd_col, and 1 otherwise; its colors
+     * are not stored but computed from colors_ (see ColorMap) */
     void parityToMultigame(){
         /* sanity check: number of games should be 1 */
         if (n_games_ != 1 || all_colors_.size() != 1){
@@ -477,28 +567,23 @@ public:
         }
         /* clear the multigame parts except gamegraph (all_colors, n_games) */
         all_colors_.clear();
+        thresholds_.clear();
+        all_max_color_.clear();
         n_games_ = 0;
 
-        /* for every odd color create a new color_vector for new game */
-        for (size_t odd_col = 1; odd_col <= max_color_; odd_col+= 2){
-            std::map<size_t, size_t> colors; /* new color vector */
-            for (auto vertex : vertices_){/* loop through each vertex */
-                if (colors_[vertex] < odd_col){ 
-                    colors.insert(std::make_pair(vertex,0)); /* new color of vertices with color < odd_col is 0 */
-                }
-                else if (colors_[vertex] == odd_col){
-                    colors.insert(std::make_pair(vertex,1)); /* new color of vertices with color = odd_col is 1 */
-                }
-                else{
-                    if (colors_[vertex]%2 == 0){
-                        colors.insert(std::make_pair(vertex,2)); /* new color of vertices with even color > odd_col is 2 */
-                    }
-                    else{
-                        colors.insert(std::make_pair(vertex,1)); /* new color of vertices with odd color > odd_col is 1 */
-                    }
-                } 
+        /* maximum even color and maximum color of the vertices */
+        size_t max_even = 0, max_all = 0;
+        for (auto vertex : vertices_){
+            max_all = std::max(max_all, colors_[vertex]);
+            if (colors_[vertex]%2 == 0){
+                max_even = std::max(max_even, colors_[vertex]);
             }
-            all_colors_.push_back(colors);
+        }
+        /* for every odd color add a threshold view of the colors as new game */
+        for (size_t odd_col = 1; odd_col <= max_color_; odd_col+= 2){
+            all_colors_.add_view();
+            thresholds_.push_back(odd_col);
+            all_max_color_.push_back(max_even > odd_col ? 2 : (max_all >= odd_col ? 1 : 0));
             n_games_ += 1;
         }
     }
@@ -525,13 +610,13 @@ public:
     /* function: max_odd
      *
      * return minimum odd color that is greater than or equal to max_color */
-    size_t max_odd(const std::map<size_t, size_t>& colors) const {
+    size_t max_odd(const ColorMap& colors) const {
         size_t odd_col = 1;
-        for (auto const & col : colors){
-            if (col.second%2 == 1 && col.second > odd_col)
-                odd_col = col.second;
-            else if (col.second%2 == 0 && col.second > odd_col)
-                odd_col = col.second+1;
+        for (auto v : vertices_){
+            if (colors[v]%2 == 1 && colors[v] > odd_col)
+                odd_col = colors[v];
+            else if (colors[v]%2 == 0 && colors[v] > odd_col)
+                odd_col = colors[v]+1;
         }
         return odd_col;
     }
@@ -567,20 +652,15 @@ public:
         vertices_= set_complement(set);
         n_vert_ = vertices_.size();
         
-        map_remove_keys(vert_id_, set);
-        
-        for (auto& colors: all_colors_){
-            map_remove_keys(colors, set);
-            max_color_ = std::max(max_color_, max_col(colors));
+        for (size_t i = 0; i < n_games_; i++){
+            max_color_ = std::max(max_color_, max_col(objective_colors(i)));
         }
-        colors_ = all_colors_[0];
-
-        map_remove_keys(edges_, set);
-        n_edge_ = 0;
-        for (auto v : vertices_){
-            edges_.at(v) = set_difference(edges_.at(v),set);
-            n_edge_ += edges_.at(v).size();
+        if (thresholds_.empty()){ /* colors_ is the base of the threshold views otherwise */
+            colors_ = all_colors_.to_vector(0);
         }
+
+        graph_ = graph_.restrict(vertex_mask(vertices_));
+        n_edge_ = graph_.n_edge_;
         /* sanity check */
         // valid_game();
     }
@@ -594,37 +674,21 @@ public:
         game.n_vert_ = set.size();
         game.vertices_= set;
 
-        std::set<size_t> complement = set_complement(set);
-        map_remove_keys(game.vert_id_, complement);
-        
-        for (auto& colors: game.all_colors_){
-            map_remove_keys(colors, set);
-            game.max_color_ = std::max(game.max_color_, max_col(colors));
+        for (size_t i = 0; i < game.n_games_; i++){
+            game.max_color_ = std::max(game.max_color_, game.max_col(game.objective_colors(i)));
         }
-        game.colors_ = game.all_colors_[0];
-
-        map_remove_keys(game.edges_, set);
-        game.n_edge_ = 0;
-        for (auto v : game.vertices_){
-            game.edges_.at(v) = set_difference(game.edges_.at(v),complement);
-            game.n_edge_ += game.edges_.at(v).size();
+        if (game.thresholds_.empty()){ /* colors_ is the base of the threshold views otherwise */
+            game.colors_ = game.all_colors_.to_vector(0);
         }
+
+        game.graph_ = graph_.restrict(vertex_mask(set));
+        game.n_edge_ = game.graph_.n_edge_;
         /* sanity check */
         // game.valid_game();
 
         return game;
     }
 
-    /* function: map_remove
-     *
-     * remove set of values from one map (set of edges) */
-    
-    void map_remove(std::map<size_t, std::set<size_t>>& map2, const std::map<size_t, std::set<size_t>>& map1) const {
-        for (auto v = map1.begin(); v != map1.end(); v++){
-            map2[v->first] = set_difference(map2[v->first], v->second);
-        }
-    }
-
     /* print game informations */
     int print_game(){
         if (labels_.empty()){
@@ -0,0 +1,353 @@
+/*
+ * Class: SlicedGame
+ *
+ *  Class formalizing up to 64 parity games on the same graph solved together (one game per bit of a word)
+ */
+
+#ifndef SLICEDGAME_HPP_
+#define SLICEDGAME_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <span>
+
+#include "Graph.hpp"
+#include "VertexSet.hpp"
+#include "ColorIndex.hpp"
+#include "Template.hpp"
+
+namespace mpa {
+/* class for the parity games with the given colors on one graph: a set of vertices of every game is stored
+ * as one word per vertex whose i-th bit says if the vertex is in the set of the i-th game (a lane), so that
+ * the attractors, the steps of zielonka's algorithm and the templates of all games are computed in one pass
+ * over the edges (the graph has to outlive the games) */
+class SlicedGame {
+public:
+    /* sets of vertices of all lanes (indexed by dense ids) */
+    using Lanes = std::vector<uint64_t>;
+
+    /* graph of the games */
+    const Graph* graph_;
+    /* number of lanes */
+    size_t n_lanes_;
+    /* maximum of colors of all lanes */
+    size_t max_color_;
+    /* vertices with color c in some lane are vertex_[color_begin_[c]],...,vertex_[color_begin_[c+1]-1]
+     * (increasing), and lane_[k] are the lanes in which vertex_[k] has color c */
+    std::vector<size_t> color_begin_;
+    std::vector<size_t> vertex_;
+    std::vector<uint64_t> lane_;
+public:
+    /* games with the colors colors[0],...,colors[n-1] (indexed by dense ids, at most 64 of them) */
+    SlicedGame(const Graph& graph, const std::vector<ColorMap>& colors):
+        graph_(&graph), n_lanes_(colors.size()), max_color_(0) {
+        if (n_lanes_ > 64){
+            throw std::runtime_error("[ERROR] SlicedGame: at most 64 games can be solved together.");
+        }
+        for (const auto& col : colors){
+            for (size_t v = 0; v < graph.n_vert_; v++){
+                max_color_ = std::max(max_color_, col[v]);
+            }
+        }
+        /* lanes of every vertex with every color, stored by colors */
+        std::vector<Lanes> by_color(max_color_+1, Lanes(graph.n_vert_, 0));
+        for (size_t i = 0; i < n_lanes_; i++){
+            for (size_t v = 0; v < graph.n_vert_; v++){
+                by_color[colors[i][v]][v] |= uint64_t(1) << i;
+            }
+        }
+        color_begin_.push_back(0);
+        for (size_t c = 0; c <= max_color_; c++){
+            for (size_t v = 0; v < graph.n_vert_; v++){
+                if (by_color[c][v] != 0){
+                    vertex_.push_back(v);
+                    lane_.push_back(by_color[c][v]);
+                }
+            }
+            color_begin_.push_back(vertex_.size());
+        }
+    }
+
+    /* function: solve
+     *
+     * the losing region (for player 0) of every lane restricted to the vertices in vertices; if strats is
+     * not empty, the template of the i-th lane is added to strats[i] (the same template as solve_parity
+     * computes for the game of the lane) */
+    std::vector<VertexSet> solve(const VertexSet& vertices, std::span<Template> strats = {}) const {
+        Lanes game(graph_->n_vert_, 0);
+        uint64_t all = (n_lanes_ == 64) ? ~uint64_t(0) : (uint64_t(1) << n_lanes_) - 1;
+        for (auto v : vertices){
+            game[v] = all;
+        }
+        Lanes winning = zielonka(max_color_, game, strats);
+        std::vector<VertexSet> losing(n_lanes_, VertexSet(graph_->n_vert_));
+        for (auto& region : losing){
+            region.make_dense();
+        }
+        for (size_t v = 0; v < graph_->n_vert_; v++){
+            for (uint64_t lost = game[v] & ~winning[v]; lost != 0; lost &= lost - 1){
+                losing[__builtin_ctzll(lost)].insert(v);
+            }
+        }
+        return losing;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Solving all lanes together
+    ///////////////////////////////////////////////////////////////
+
+    /* function: attractor
+     *
+     * vertices of game from which player can force to visit target in every lane (as in
+     * GameView::solve_reachability_game, the vertices without successors in the game are attracted) */
+    Lanes attractor(const Lanes& target, const Lanes& game, const size_t player) const {
+        Lanes attr(graph_->n_vert_, 0);
+        std::vector<size_t> worklist; /* vertices whose predecessors have to be updated */
+        std::vector<bool> listed(graph_->n_vert_, false);
+        for (size_t v = 0; v < graph_->n_vert_; v++){
+            attr[v] = target[v] & game[v];
+        }
+        for (size_t v = 0; v < graph_->n_vert_; v++){
+            if (game[v] != 0 && (attr[v] |= attracted(v, attr, game, player)) != 0){
+                listed[v] = true;
+                worklist.push_back(v);
+            }
+        }
+        while (!worklist.empty()){
+            size_t u = worklist.back();
+            worklist.pop_back();
+            listed[u] = false;
+            for (auto v : graph_->predecessors(u)){
+                if ((game[v] & ~attr[v] & attr[u]) == 0){ /* no lane of v can change */
+                    continue;
+                }
+                uint64_t new_attr = attr[v] | attracted(v, attr, game, player);
+                if (new_attr != attr[v]){
+                    attr[v] = new_attr;
+                    if (!listed[v]){
+                        listed[v] = true;
+                        worklist.push_back(v);
+                    }
+                }
+            }
+        }
+        return attr;
+    }
+
+    /* lanes in which v is attracted by its successors */
+    uint64_t attracted(const size_t v, const Lanes& attr, const Lanes& game, const size_t player) const {
+        uint64_t some = 0; /* lanes with a successor in attr */
+        uint64_t every = ~uint64_t(0); /* lanes without a successor outside attr */
+        for (auto u : graph_->successors(v)){
+            some |= attr[u];
+            every &= attr[u] | ~game[u];
+        }
+        /* the lanes without successors are included in every */
+        return game[v] & (graph_->owner(v) == player ? (some | every) : every);
+    }
+
+    /* zielonka's algorithm on the lanes whose colors in game are at most c: the winning region of player 0
+     * in every lane (as in Solver, the subgames with the same maximum color are handled in a loop and the
+     * lanes without color c are solved with the smaller colors; if strats is not empty, the template of
+     * every lane is added to it in the same order as Solver) */
+    Lanes zielonka(const size_t c, Lanes game, std::span<Template> strats) const {
+        Lanes won(graph_->n_vert_, 0); /* vertices won by the opponent of the player of c so far */
+        Lanes initial = game;
+        const size_t player = c % 2;
+        while (true){
+            uint64_t active = 0; /* lanes with vertices left */
+            for (auto lanes : game){
+                active |= lanes;
+            }
+            if (active == 0){
+                break;
+            }
+            /* vertices with color c in the game, and the lanes with such vertices */
+            Lanes max_col_vertices(graph_->n_vert_, 0);
+            uint64_t with_c = 0;
+            for (size_t k = color_begin_[c]; k < color_begin_[c+1]; k++){
+                max_col_vertices[vertex_[k]] = lane_[k] & game[vertex_[k]];
+                with_c |= max_col_vertices[vertex_[k]];
+            }
+            if (with_c != active){ /* the other lanes are solved with the smaller colors (c > 0 as all colors are at most c) */
+                Lanes rest(graph_->n_vert_, 0);
+                for (size_t v = 0; v < graph_->n_vert_; v++){
+                    rest[v] = game[v] & ~with_c;
+                    game[v] &= with_c;
+                }
+                Lanes rest_won = zielonka(c-1, rest, strats);
+                for (size_t v = 0; v < graph_->n_vert_; v++){
+                    won[v] |= (player == V0) ? rest[v] & ~rest_won[v] : rest_won[v];
+                }
+                if (with_c == 0){
+                    break;
+                }
+            }
+            /* vertices from which player can force to visit max_col_vertices */
+            Lanes regionA = attractor(max_col_vertices, game, player);
+            Lanes gameCA(graph_->n_vert_, 0); /* game with regionA removed */
+            for (size_t v = 0; v < graph_->n_vert_; v++){
+                gameCA[v] = game[v] & ~regionA[v];
+            }
+            /* winning region of the opponent in gameCA */
+            Lanes winCA = (c == 0) ? Lanes(graph_->n_vert_, 0) : zielonka(c-1, gameCA, strats);
+            uint64_t lost = 0; /* lanes in which the opponent wins some vertex of gameCA */
+            for (size_t v = 0; v < graph_->n_vert_; v++){
+                winCA[v] = (player == V0) ? gameCA[v] & ~winCA[v] : winCA[v];
+                lost |= winCA[v];
+            }
+            if (!strats.empty() && player == V0){
+                /* live groups needed to reach max even color from regionA in the lanes in which player 0 wins */
+                live_groups_reach(max_col_vertices, game, with_c & ~lost, strats);
+            }
+            /* player wins the rest of the game in the other lanes */
+            for (auto& lanes : game){
+                lanes &= lost;
+            }
+            /* vertices from which the opponent can force to reach its winning region of gameCA */
+            Lanes regionB = attractor(winCA, game, 1 - player);
+            if (!strats.empty() && player == V1){
+                /* edges from winning region of gameCA to regionB are colive, and live groups are needed to reach
+                 * winning region of gameCA from regionB */
+                colive_edges(winCA, game, strats);
+                live_groups_reach(winCA, game, lost, strats);
+            }
+            for (size_t v = 0; v < graph_->n_vert_; v++){
+                won[v] |= regionB[v];
+                game[v] &= ~regionB[v];
+            }
+        }
+        /* the winning region of player 0 */
+        if (player == V0){
+            for (size_t v = 0; v < graph_->n_vert_; v++){
+                won[v] = initial[v] & ~won[v];
+            }
+        }
+        return won;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Templates of all lanes
+    ///////////////////////////////////////////////////////////////
+
+    /* function: colive_edges
+     *
+     * the player 0's edges from region to the rest of the game (as GameView::edges_between) are added to the
+     * colive edges of every lane */
+    void colive_edges(const Lanes& region, const Lanes& game, std::span<Template> strats) const {
+        std::vector<EdgeSet> colive(n_lanes_);
+        for (size_t v = 0; v < graph_->n_vert_; v++){
+            if (region[v] == 0 || graph_->owner(v) != V0){
+                continue;
+            }
+            for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1]; i++){
+                size_t u = graph_->succ_[i];
+                for (uint64_t lanes = region[v] & game[u] & ~region[u]; lanes != 0; lanes &= lanes - 1){
+                    colive[__builtin_ctzll(lanes)].push_back(graph_->edge_id(i));
+                }
+            }
+        }
+        for (size_t i = 0; i < n_lanes_; i++){
+            strats[i].edge_merge(strats[i].colive_edges_, colive[i]);
+        }
+    }
+
+    /* function: live_groups_reach
+     *
+     * live groups needed to reach target in the given lanes of the game (as GameView::find_live_groups_reach
+     * from the attractor of player 0 of target): the layers of all lanes are computed together, a layer is the
+     * set of vertices from which no player can avoid the previous layers, and the player 0's edges from the
+     * other vertices into it form the live group of the lane, whose sources start the next layer */
+    void live_groups_reach(const Lanes& target, const Lanes& game, const uint64_t lanes, std::span<Template> strats) const {
+        if (lanes == 0){
+            return;
+        }
+        Lanes attr(graph_->n_vert_, 0); /* vertices of the layers so far */
+        Lanes source(graph_->n_vert_, 0); /* lanes in which a vertex is a source of the next live group */
+        std::vector<size_t> sources; /* vertices with source lanes */
+        std::vector<size_t> worklist; /* vertices whose predecessors have to be updated */
+        std::vector<bool> listed(graph_->n_vert_, false);
+        /* attract v in the lanes in which all of its successors are attracted, and mark the other lanes in
+         * which v (of player 0) has an attracted successor */
+        auto update = [&](const size_t v){
+            uint64_t open = game[v] & lanes & ~attr[v];
+            if (open == 0){
+                return;
+            }
+            uint64_t some = 0; /* lanes with a successor in attr */
+            uint64_t every = ~uint64_t(0); /* lanes without a successor outside attr */
+            for (auto u : graph_->successors(v)){
+                some |= attr[u];
+                every &= attr[u] | ~game[u];
+            }
+            if ((open & every) != 0){
+                attr[v] |= open & every;
+                if (!listed[v]){
+                    listed[v] = true;
+                    worklist.push_back(v);
+                }
+            }
+            uint64_t new_source = (graph_->owner(v) == V0) ? open & ~every & some & ~source[v] : 0;
+            if (new_source != 0){
+                if (source[v] == 0){
+                    sources.push_back(v);
+                }
+                source[v] |= new_source;
+            }
+        };
+        for (size_t v = 0; v < graph_->n_vert_; v++){
+            attr[v] = target[v] & game[v] & lanes;
+        }
+        for (size_t v = 0; v < graph_->n_vert_; v++){
+            if (attr[v] != 0){
+                listed[v] = true;
+                worklist.push_back(v);
+            }
+            /* every successor of a dead-end is (vacuously) attracted */
+            update(v);
+        }
+        while (true){
+            /* vertices from which no player can avoid the attracted vertices */
+            while (!worklist.empty()){
+                size_t u = worklist.back();
+                worklist.pop_back();
+                listed[u] = false;
+                for (auto v : graph_->predecessors(u)){
+                    update(v);
+                }
+            }
+            /* live group of every lane containing player 0's edges from outside into the attracted vertices */
+            std::sort(sources.begin(), sources.end());
+            std::vector<EdgeSet> live_groups(n_lanes_);
+            bool found = false;
+            for (auto v : sources){
+                source[v] &= ~attr[v];
+                for (size_t i = graph_->succ_begin_[v]; i < graph_->succ_begin_[v+1]; i++){
+                    for (uint64_t lane = source[v] & attr[graph_->succ_[i]]; lane != 0; lane &= lane - 1){
+                        live_groups[__builtin_ctzll(lane)].push_back(graph_->edge_id(i));
+                        found = true;
+                    }
+                }
+            }
+            if (!found){ /* no more vertex can be attracted */
+                break;
+            }
+            for (size_t i = 0; i < n_lanes_; i++){
+                strats[i].add_live_group(std::move(live_groups[i]));
+            }
+            /* the sources start the next layer */
+            for (auto v : sources){
+                attr[v] |= source[v];
+                source[v] = 0;
+                if (!listed[v]){
+                    listed[v] = true;
+                    worklist.push_back(v);
+                }
+            }
+            sources.clear();
+        }
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
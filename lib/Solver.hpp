@@ -0,0 +1,112 @@
+/*
+ * Class: Solver
+ *
+ *  Class formalizing the recursive parity algorithms specialized for a fixed maximum color
+ */
+
+#ifndef SOLVER_HPP_
+#define SOLVER_HPP_
+
+#include "GameView.hpp"
+#include "Template.hpp"
+#include "VertexSet.hpp"
+
+namespace mpa {
+/* solve the parity game of the view (and collect its template in strat if given) with the solver
+ * specialized for its maximum color (up to 4), or with the generic algorithms for larger colors */
+inline std::pair<VertexSet, VertexSet> solve_parity(const GameView& game, Template* strat = nullptr);
+
+/* class for zielonka's algorithm (computing the template as in GameView::recursive_strategy_template_parity)
+ * on views with maximum color MaxColor: the parity of every level is known at compile time, the subgames
+ * without the maximum color are solved by Solver<MaxColor-1>, and the subgames with the same maximum color
+ * (gameCB of the generic algorithm) are handled in a loop instead of a recursive call */
+template<size_t MaxColor>
+class Solver {
+public:
+    static std::pair<VertexSet, VertexSet> solve(const GameView& view, Template* strat = nullptr) {
+        if constexpr (MaxColor <= 1){ /* colors 0 and 1 */
+            return view.solve_cobuchi_game(view.vertex_with_color(0), strat);
+        }
+        else {
+            VertexSet won(view.graph_->n_vert_); /* vertices decided (for player 0 if MaxColor is odd, else for player 1) so far */
+            GameView game(view, view.vertices_); /* game with the decided vertices removed */
+            while (true){
+                if (game.n_vert_ == 0 || game.max_color_ != MaxColor || game.is_buchi()){
+                    /* the rest of the game is solved by a smaller (or the Buechi) solver */
+                    auto rest = (game.max_color_ == MaxColor) ? game.solve_buchi_game(game.vertex_with_color(2), strat)
+                                                              : solve_parity(game, strat);
+                    return combine(view, won, rest);
+                }
+                /* vertices with maximum color */
+                VertexSet max_col_vertices = game.vertex_with_color(MaxColor);
+                if constexpr (MaxColor % 2 == 1){
+                    /* vertices from which player 1 can force to visit max_col_vertices (odd) */
+                    auto regionA = game.solve_reachability_game(max_col_vertices, {V1});
+                    auto winCA = Solver<MaxColor-1>::solve(game.subgame(std::move(regionA.second)), strat);
+                    if (winCA.first.empty()){ /* player 0 wins nothing in the rest of the game */
+                        return combine(view, won, std::make_pair(std::move(winCA.first), game.vertices_));
+                    }
+                    /* vertices from which player 0 can force to reach winning region of gameCA */
+                    auto regionB = game.solve_reachability_game(winCA.first, {V0});
+                    if (strat){
+                        /* edges from winning region of gameCA to regionB (all are player 0's) are colive */
+                        strat->edge_merge(strat->colive_edges_, game.edges_between(winCA.first, game.set_complement(winCA.first)));
+                        /* live groups needed to reach winCA from regionB */
+                        game.find_live_groups_reach(winCA.first, regionB.first, *strat);
+                    }
+                    won |= regionB.first;
+                    game = game.subgame(std::move(regionB.second));
+                }
+                else {
+                    /* vertices from which player 0 can force to visit max_col_vertices (even) */
+                    auto regionA = game.solve_reachability_game(max_col_vertices, {V0});
+                    auto winCA = Solver<MaxColor-1>::solve(game.subgame(std::move(regionA.second)), strat);
+                    if (winCA.second.empty()){ /* player 0 wins the rest of the game */
+                        if (strat){
+                            /* live groups needed to reach max even color from regionA */
+                            game.find_live_groups_reach(max_col_vertices, regionA.first, *strat);
+                        }
+                        return combine(view, won, std::make_pair(game.vertices_, std::move(winCA.second)));
+                    }
+                    /* vertices from which player 1 can force to reach losing region of gameCA */
+                    auto regionB = game.solve_reachability_game(winCA.second, {V1});
+                    won |= regionB.first;
+                    game = game.subgame(std::move(regionB.second));
+                }
+            }
+        }
+    }
+
+private:
+    /* winning regions of view from the decided vertices and the regions of the rest of the game */
+    static std::pair<VertexSet, VertexSet> combine(const GameView& view, VertexSet& won, std::pair<VertexSet, VertexSet> rest) {
+        if constexpr (MaxColor % 2 == 1){
+            won |= rest.first;
+            VertexSet lost = view.vertices_ - won;
+            return std::make_pair(std::move(won), std::move(lost));
+        }
+        else {
+            won |= rest.second;
+            VertexSet lost = view.vertices_ - won;
+            return std::make_pair(std::move(lost), std::move(won));
+        }
+    }
+}; /* close class definition */
+
+inline std::pair<VertexSet, VertexSet> solve_parity(const GameView& game, Template* strat) {
+    switch (game.max_color_){
+        case 0: return Solver<0>::solve(game, strat);
+        case 1: return Solver<1>::solve(game, strat);
+        case 2: return Solver<2>::solve(game, strat);
+        case 3: return Solver<3>::solve(game, strat);
+        case 4: return Solver<4>::solve(game, strat);
+        default:
+            if (strat){
+                return game.recursive_strategy_template_parity(*strat);
+            }
+            return game.recursive_zielonka_parity();
+    }
+}
+} /* close namespace */
+
+#endif
@@ -12,8 +12,12 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
+#include <unordered_set>
+#include <unordered_map>
 #include <queue>
 #include <algorithm>
+#include <iterator>
 #include <stack> 
 
 namespace mpa {
@@ -87,28 +91,48 @@ public:
     }
 }; 
 
+/* set of edges given by their ids (see Graph::edge_ids_) in increasing order */
+using EdgeSet = std::vector<size_t>;
+
+/* live group: an immutable set of edges, shared by all templates that contain it */
+using LiveGroup = std::shared_ptr<const EdgeSet>;
+
+/* hash of a live group (computed from its edges) */
+struct LiveGroupHash {
+    size_t operator()(const LiveGroup& live_group) const {
+        size_t hash = live_group->size();
+        for (auto e : *live_group){
+            hash ^= e + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+/* equality of live groups (by their edges) */
+struct LiveGroupEqual {
+    bool operator()(const LiveGroup& live_group1, const LiveGroup& live_group2) const {
+        return live_group1 == live_group2 || *live_group1 == *live_group2;
+    }
+};
+
+/* set of live groups (without duplicates) */
+using LiveGroupSet = std::unordered_set<LiveGroup, LiveGroupHash, LiveGroupEqual>;
+
 /* class for template */
 class Template {
 public:
     /* set of unsafe edges */
-    std::map<size_t, std::set<size_t>> unsafe_edges_;
+    EdgeSet unsafe_edges_;
     /* set of colive edges */
-    std::map<size_t, std::set<size_t>> colive_edges_;
+    EdgeSet colive_edges_;
     /* vector of condition sets */
     std::vector<std::set<size_t>> cond_sets_;
-    /* a vector of live groups */
-    std::vector<std::map<size_t, std::set<size_t>>> live_groups_;
+    /* a vector of live groups (nonempty and without duplicates) */
+    std::vector<LiveGroup> live_groups_;
+    /* the live groups of live_groups_ (to find duplicates in constant time) */
+    LiveGroupSet live_group_set_;
     /* set of conditional live groups (mapping from the conditions sets) */
-    std::vector<std::vector<std::map<size_t, std::set<size_t>>>> cond_live_groups_;
-
-    /* set of unsafe strings */
-    std::map<size_t, std::set<std::string>> unsafe_strings_;
-    /* set of colive strings */
-    std::map<size_t, std::set<std::string>> colive_strings_;
-    /* a vector of live groups for strings */
-    std::vector<std::map<size_t, std::set<std::string>>> live_groups_strings_;
-    /* set of conditional live groups for strings (mapping from the conditions sets) */
-    std::vector<std::vector<std::map<size_t, std::set<std::string>>>> cond_live_groups_strings_;
+    std::vector<std::vector<LiveGroup>> cond_live_groups_;
 public:
     /* default constructor */
     Template() {}
@@ -118,30 +142,89 @@ public:
     /// Operators
     ///////////////////////////////////////////////////////////////
 
+    /* add a live group (if it is nonempty and not yet in the template)
+     * output: if the live group is added */
+    bool add_live_group(const LiveGroup& live_group){
+        if (live_group->empty() || !live_group_set_.insert(live_group).second){
+            return false;
+        }
+        live_groups_.push_back(live_group);
+        return true;
+    }
+    bool add_live_group(EdgeSet live_group){
+        if (live_group.empty()){
+            return false;
+        }
+        return add_live_group(std::make_shared<const EdgeSet>(std::move(live_group)));
+    }
+    /* add live groups (the live groups are shared, not copied) */
+    void add_live_groups(const std::vector<LiveGroup>& live_groups){
+        for (const auto& live_group : live_groups){
+            add_live_group(live_group);
+        }
+    }
+
+    /* replace every live group by f(live group), where f only removes edges (the live groups that
+     * become empty are removed and the ones that become equal are merged) */
+    template<class F>
+    void transform_live_groups(F f){
+        std::vector<LiveGroup> live_groups;
+        live_groups.swap(live_groups_);
+        live_group_set_.clear();
+        for (const auto& live_group : live_groups){
+            EdgeSet edges = f(*live_group);
+            if (edges.size() == live_group->size()){ /* nothing is removed */
+                add_live_group(live_group);
+            }
+            else{
+                add_live_group(std::move(edges));
+            }
+        }
+    }
+
     /* merge a new template */
     void merge(const Template& new_temp){
         edge_merge(unsafe_edges_, new_temp.unsafe_edges_);
         edge_merge(colive_edges_, new_temp.colive_edges_);
-        live_groups_.insert(live_groups_.end(), new_temp.live_groups_.begin(), new_temp.live_groups_.end());
+        add_live_groups(new_temp.live_groups_);
         cond_sets_.insert(cond_sets_.end(),new_temp.cond_sets_.begin(), new_temp.cond_sets_.end());
         cond_live_groups_.insert(cond_live_groups_.end(),new_temp.cond_live_groups_.begin(),new_temp.cond_live_groups_.end());
     }
     /* merge new set of edges to this set of edges */
-    void edge_merge(std::map<size_t, std::set<size_t>>& edges, const std::map<size_t, std::set<size_t>>& new_edges) const {
-        for (auto v = new_edges.begin(); v != new_edges.end(); v++){
-            edges[v->first].insert(v->second.begin(), v->second.end());
+    void edge_merge(EdgeSet& edges, const EdgeSet& new_edges) const {
+        if (new_edges.empty()){
+            return;
         }
+        EdgeSet result;
+        result.reserve(edges.size() + new_edges.size());
+        std::set_union(edges.begin(), edges.end(), new_edges.begin(), new_edges.end(), std::back_inserter(result));
+        edges.swap(result);
+    }
+    /* remove a set of edges from this set of edges */
+    void edge_remove(EdgeSet& edges, const EdgeSet& old_edges) const {
+        if (old_edges.empty()){
+            return;
+        }
+        EdgeSet result;
+        result.reserve(edges.size());
+        std::set_difference(edges.begin(), edges.end(), old_edges.begin(), old_edges.end(), std::back_inserter(result));
+        edges.swap(result);
+    }
+    /* check if the edge with id e is in the set of edges */
+    bool has_edge(const EdgeSet& edges, const size_t e) const {
+        return std::binary_search(edges.begin(), edges.end(), e);
     }
 
-    /* merge all colive edges and live groups (in cond_live_groups_) with another template */
+    /* merge all colive edges and live groups (in cond_live_groups_) with another template
+     * (live groups that are already in the template are not added again) */
     void merge_live_colive(const Template& new_temp){
         edge_merge(colive_edges_, new_temp.colive_edges_);
-        live_groups_.insert(live_groups_.end(), new_temp.live_groups_.begin(), new_temp.live_groups_.end());
+        add_live_groups(new_temp.live_groups_);
         for (const auto& live_groups : cond_live_groups_){
-            live_groups_.insert(live_groups_.end(), live_groups.begin(), live_groups.end());
+            add_live_groups(live_groups);
         }
         for (const auto& live_groups : new_temp.cond_live_groups_){
-            live_groups_.insert(live_groups_.end(), live_groups.begin(), live_groups.end());
+            add_live_groups(live_groups);
         }
     }
 
@@ -172,6 +255,11 @@ public:
         return result;
     }
 
+    /* check if the template has no restriction */
+    bool empty() const {
+        return unsafe_edges_.empty() && colive_edges_.empty() && live_groups_.empty() && cond_live_groups_.empty();
+    }
+
     ///////////////////////////////////////////////////////////////
     /// Clean/clear elements
     ///////////////////////////////////////////////////////////////
@@ -181,262 +269,68 @@ public:
         unsafe_edges_.clear();
         colive_edges_.clear();
         live_groups_.clear();
+        live_group_set_.clear();
         cond_sets_.clear();
         cond_live_groups_.clear();
     }
 
-    /* clean the keys with empty value in a map of edges */
-    void clean_edges(std::map<size_t, std::set<size_t>>& edges) const {
-        for (auto v = edges.begin(); v != edges.end();) {
-            if (v->second.empty()){
-                edges.erase(v++);
-            }
-            else{
-                ++v;
-            }
-        }
-    }
-
-    /* clean keys with empty value in unsafe edges */
-    void clean_unsafe_edges(){
-        clean_edges(unsafe_edges_);
-    }
-
-    /* clean keys with empty value in colive edges */
-    void clean_colive_edges(){
-        clean_edges(colive_edges_);
-    }
-
-    /* clean empty live group in a vector of live groups */
-    void clean_live_groups(std::vector<std::map<size_t, std::set<size_t>>>& live_groups) const {
-        std::vector<std::map<size_t, std::set<size_t>>> new_live_groups;
-        for (auto& live_group : live_groups){
-            clean_edges(live_group);
-            if (!live_group.empty()){
+    /* clean empty and duplicate live groups in a vector of live groups (in linear time) */
+    void clean_live_groups(std::vector<LiveGroup>& live_groups) const {
+        LiveGroupSet live_group_set;
+        std::vector<LiveGroup> new_live_groups;
+        for (const auto& live_group : live_groups){
+            if (!live_group->empty() && live_group_set.insert(live_group).second){
                 new_live_groups.push_back(live_group);
             }
         }
-        live_groups = new_live_groups;
-        /* remove duplicate live groups */
-        std::sort(live_groups.begin(), live_groups.end());
-        live_groups.erase(std::unique(live_groups.begin(), live_groups.end()), live_groups.end());
-    }
-    /* clean empty live group in live_groups_ */
-    void clean_live_groups() {
-        clean_live_groups(live_groups_);
+        live_groups.swap(new_live_groups);
     }
 
     /* clean empty live groups from cond_live_groups_ */
     void clean_cond_live_groups(){
+        /* hash and equality of a vector of live groups */
+        auto hash = [](const std::vector<LiveGroup>* live_groups){
+            size_t result = live_groups->size();
+            for (const auto& live_group : *live_groups){
+                result ^= LiveGroupHash()(live_group) + 0x9e3779b97f4a7c15 + (result << 6) + (result >> 2);
+            }
+            return result;
+        };
+        auto equal = [](const std::vector<LiveGroup>* live_groups1, const std::vector<LiveGroup>* live_groups2){
+            return std::equal(live_groups1->begin(), live_groups1->end(), live_groups2->begin(), live_groups2->end(), LiveGroupEqual());
+        };
+        /* position of the (first) condition set of every vector of live groups */
+        std::unordered_map<const std::vector<LiveGroup>*, size_t, decltype(hash), decltype(equal)> position(cond_sets_.size(), hash, equal);
         std::vector<std::set<size_t>> new_cond_sets;
-        std::vector<std::vector<std::map<size_t, std::set<size_t>>>> new_cond_live_groups;
+        std::vector<std::vector<LiveGroup>> new_cond_live_groups;
+        new_cond_live_groups.reserve(cond_sets_.size()); /* the keys of position point into this vector */
         for (size_t i = 0; i < cond_sets_.size(); i++){
-            if (!cond_sets_[i].empty()){
-                clean_live_groups(cond_live_groups_[i]);
-                if (!cond_live_groups_[i].empty()){
-                    new_cond_sets.push_back(cond_sets_[i]);
-                    new_cond_live_groups.push_back(cond_live_groups_[i]);
-                }
+            if (cond_sets_[i].empty()){
+                continue;
             }
-        }
-        cond_sets_ = new_cond_sets;
-        cond_live_groups_ = new_cond_live_groups;
-        /* merge cond_sets if the corresponding live groups are the same (and remove the duplicate) */
-        for (size_t i = 0; i < cond_sets_.size(); i++){
-            for (size_t j = i+1; j < cond_sets_.size(); j++){
-                if (cond_live_groups_[i] == cond_live_groups_[j]){
-                    cond_sets_[i].insert(cond_sets_[j].begin(), cond_sets_[j].end());
-                    cond_sets_.erase(cond_sets_.begin()+j);
-                    cond_live_groups_.erase(cond_live_groups_.begin()+j);
-                    j -= 1;
-                }
+            clean_live_groups(cond_live_groups_[i]);
+            if (cond_live_groups_[i].empty()){
+                continue;
+            }
+            /* merge cond_sets if the corresponding live groups are the same */
+            auto it = position.find(&cond_live_groups_[i]);
+            if (it != position.end()){
+                new_cond_sets[it->second].insert(cond_sets_[i].begin(), cond_sets_[i].end());
+                continue;
             }
+            new_cond_sets.push_back(cond_sets_[i]);
+            new_cond_live_groups.push_back(std::move(cond_live_groups_[i]));
+            position.emplace(&new_cond_live_groups.back(), new_cond_sets.size()-1);
         }
+        cond_sets_.swap(new_cond_sets);
+        cond_live_groups_.swap(new_cond_live_groups);
     }
 
-    /* clean every empty things from the template */
+    /* clean every empty things from the template (the edge sets have no empty parts and
+     * live_groups_ has no empty or duplicate live groups) */
     void clean(){
-        clean_unsafe_edges();
-        clean_colive_edges();
-        clean_live_groups();
         clean_cond_live_groups();
     }
-
-    ///////////////////////////////////////////////////////////////
-    /// Compute strings from template if needed
-    ///////////////////////////////////////////////////////////////
-
-    /* convert set of size_t to set of strings */
-    std::set<std::string> set_to_string(const std::set<size_t>& set) const {
-        std::set<std::string> result;
-        for (auto element : set){
-            result.insert(std::to_string(element));
-        }
-        return result;
-    }
-
-    /* compute strings from the template */
-    void compute_strings() {
-        for (auto& pair : unsafe_edges_){
-            unsafe_strings_[pair.first] = set_to_string(pair.second);
-        }
-        for (auto& pair : colive_edges_){
-            colive_strings_[pair.first] = set_to_string(pair.second);
-        }
-        for (auto& live_group : live_groups_){
-            std::map<size_t, std::set<std::string>> live_group_strings;
-            for (auto& pair : live_group){
-                live_group_strings[pair.first] = set_to_string(pair.second);
-            }
-            live_groups_strings_.push_back(live_group_strings);
-        }
-        for (auto& live_groups : cond_live_groups_){
-            std::vector<std::map<size_t, std::set<std::string>>> cond_live_strings;
-            for (auto& live_group : live_groups){
-                std::map<size_t, std::set<std::string>> live_group_strings;
-                for (auto& pair : live_group){
-                    live_group_strings[pair.first] = set_to_string(pair.second);
-                }
-                cond_live_strings.push_back(live_group_strings);
-            }
-            cond_live_groups_strings_.push_back(cond_live_strings);
-        }
-    }
-
-
-    
-    ///////////////////////////////////////////////////////////////
-    /// Print functions
-    ///////////////////////////////////////////////////////////////
-
-    /* function: print_size
-     *
-     * print out size of all template */
-    void print_size(){
-        clean();
-        std::cout << "\n";
-        std::cout << "#unsafe_edges:     "<< size_unsafe()<<"\n";
-        std::cout << "#colive_edges:     "<< size_colive()<<"\n";
-        std::cout << "#live_groups:      "<< size_live() <<"\n";
-        // std::cout << "#cond_live_groups: "<< size_cond_live() <<"\n";
-    }
-
-    
-    /* function: print_edges
-     *
-     * print out all edges of the map */
-    void print_edges (const std::map<size_t, std::set<std::string>>& edges_string, const std::string note = "edges", const int print_empty = 1) const {
-        if (print_empty == 1 || edges_string.size()!=0){
-            std::cout << "\n" << note << ": \n";
-            for (auto v = edges_string.begin(); v != edges_string.end(); ++v){
-                for (const auto& u : v->second){
-                    std::cout << v->first << " -> " << u << "\n";
-                }
-            }
-        }
-    }
-
-    /* function: print_unsafe_edges
-     *
-     * print out all unsafe edges */
-    void print_unsafe_edges (const std::string note = "Unsafe edges", 
-                            const int print_empty = 0) const {
-    print_edges(unsafe_strings_, note, print_empty);
-    }
-
-    /* function: print_colive_edges
-     *
-     * print out all colive edges */
-    void print_colive_edges (const std::string note = "Colive edges", 
-                            const int print_empty = 0) const {
-    print_edges(colive_strings_, note, print_empty);
-    }
-
-
-    /* function: print_live_groups
-     *
-     * print out all live_groups of the live_groups */
-    void print_live_groups (const std::vector<std::map<size_t, std::set<std::string>>>& live_groups_strings, const std::string note = "live groups", const int print_empty = 1) const {
-        if (print_empty == 1 || live_groups_strings.size()!=0){
-            std::cout << "\n" << note << ": \n";
-            for (const auto& live_group : live_groups_strings){
-                std::cout << "{";
-                size_t counter = 0;
-                for (auto v = live_group.begin(); v != live_group.end(); v++){
-                    for (const auto& u : v->second){
-                        if (counter == 0){
-                            std::cout << "("<<v->first << " -> " << u<<")";
-                            counter += 1;
-                        }
-                        else{
-                            std::cout << ", " <<"("<< v->first << " -> " << u<<")";
-                        }
-                    }
-                }
-                std::cout << "}\n";
-            }
-        }
-    }
-    void print_live_groups(const std::string note = "Live groups", const int print_empty = 0) const {
-        print_live_groups(live_groups_strings_, note, print_empty);
-    }
-
-
-    /* function: print_cond_live_groups
-     *
-     * print out all conditional live_groups of the cond_live_groups_ */
-    void print_cond_live_groups (const std::string note = "Conditional live groups", 
-                                const int print_empty = 0) const {
-        if (print_empty == 1 || cond_live_groups_strings_.size()!=0){
-            std::cout << "\n" << note << ": \n";
-            for (size_t i = 0; i < cond_sets_.size(); i++){
-                const auto& set = cond_sets_[i];
-                const auto& live_groups_strings = cond_live_groups_strings_[i];
-                for (const auto& live_group_string : live_groups_strings){
-                    std::cout << "{";
-                    for (auto u=set.begin(); u != set.end();){
-                        std::cout << *u;
-                        ++u;
-                        if (u != set.end())
-                            std::cout << ", ";
-                    }
-                    std::cout << "}: ";
-                
-                    std::cout << "{";
-                    size_t counter = 0;
-                    for (const auto& v : live_group_string){
-                        for (const auto& u : v.second){
-                            if (counter == 0){
-                                std::cout << "("<<v.first << " -> " << u<<")";
-                                counter += 1;
-                            }
-                            else{
-                                std::cout << ", " <<"("<< v.first << " -> " << u<<")";
-                            }
-                        }
-                    }
-                    std::cout << "}\n";
-                }
-            }
-        }
-    }
-
-    /* function: print_template
-     *
-     * print out the whole template */
-    void print_template(){
-        if (unsafe_strings_.empty() && colive_strings_.empty() && live_groups_strings_.empty() && cond_live_groups_strings_.empty()){
-            compute_strings();
-        }
-        print_unsafe_edges();
-        print_colive_edges();
-        print_live_groups();
-        print_cond_live_groups();
-        if (unsafe_edges_.empty() && colive_edges_.empty() && live_groups_.empty() && cond_live_groups_.empty()){
-            std::cout << "\nTRUE\n";
-        }
-    }
-
 }; /* close class definition */
 } /* close namespace */
 
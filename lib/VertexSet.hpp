@@ -0,0 +1,332 @@
+/*
+ * Class: VertexSet
+ *
+ *  Class formalizing a set of vertices (dense ids of a graph) as a bitset
+ */
+
+#ifndef VERTEXSET_HPP_
+#define VERTEXSET_HPP_
+
+#include <vector>
+#include <set>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include <iterator>
+
+namespace mpa {
+/* class for a set of vertices from the universe {0,...,n_-1}: the elements are stored as bits of
+ * 64-bit words (dense), or as a sorted vector while the set is not larger than the bitset (sparse) */
+class VertexSet {
+public:
+    /* size of the universe */
+    size_t n_;
+    /* number of elements */
+    size_t size_;
+    /* if the set is stored as bits */
+    bool dense_;
+    /* bits of the elements (dense representation) */
+    std::vector<uint64_t> words_;
+    /* sorted elements (sparse representation) */
+    std::vector<size_t> elems_;
+public:
+    /* empty set over the universe {0,...,n-1} */
+    explicit VertexSet(const size_t n = 0): n_(n), size_(0), dense_(false) {}
+
+    /* set with the elements of a std::set */
+    VertexSet(const size_t n, const std::set<size_t>& set): VertexSet(n) {
+        if (is_small(set.size())){
+            elems_.assign(set.begin(), set.end());
+            size_ = elems_.size();
+        }
+        else{
+            make_dense();
+            for (auto v : set){
+                insert(v);
+            }
+        }
+    }
+
+    /* iterator over the elements in increasing order */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = size_t;
+
+        const VertexSet* set_;
+        /* element (dense) or index of the element (sparse) */
+        size_t pos_;
+
+        const_iterator(): set_(nullptr), pos_(0) {}
+        const_iterator(const VertexSet* set, const size_t pos): set_(set), pos_(pos) {}
+
+        size_t operator*() const {
+            return set_->dense_ ? pos_ : set_->elems_[pos_];
+        }
+        const_iterator& operator++(){
+            pos_ = set_->dense_ ? set_->next(pos_+1) : pos_+1;
+            return *this;
+        }
+        const_iterator operator++(int){
+            const_iterator it = *this;
+            ++(*this);
+            return it;
+        }
+        bool operator==(const const_iterator& other) const {
+            return pos_ == other.pos_;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return pos_ != other.pos_;
+        }
+    };
+
+    const_iterator begin() const {
+        return const_iterator(this, dense_ ? next(0) : 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, dense_ ? n_ : elems_.size());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Access functions
+    ///////////////////////////////////////////////////////////////
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /* check if v is in the set */
+    bool contains(const size_t v) const {
+        if (dense_){
+            return (words_[v >> 6] >> (v & 63)) & 1;
+        }
+        return std::binary_search(elems_.begin(), elems_.end(), v);
+    }
+
+    /* smallest element >= v (n_ if there is none) of a dense set */
+    size_t next(const size_t v) const {
+        if (v >= n_){
+            return n_;
+        }
+        size_t i = v >> 6;
+        uint64_t word = words_[i] & (~uint64_t(0) << (v & 63));
+        while (word == 0){
+            i += 1;
+            if (i == words_.size()){
+                return n_;
+            }
+            word = words_[i];
+        }
+        return (i << 6) + std::countr_zero(word);
+    }
+
+    /* elements as a std::set */
+    std::set<size_t> to_set() const {
+        std::set<size_t> set;
+        for (auto v : *this){
+            set.insert(set.end(), v);
+        }
+        return set;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    /// Operators
+    ///////////////////////////////////////////////////////////////
+
+    /* switch to the dense representation */
+    void make_dense(){
+        if (dense_){
+            return;
+        }
+        dense_ = true;
+        words_.assign((n_+63) >> 6, 0);
+        for (auto v : elems_){
+            words_[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+        elems_.clear();
+        elems_.shrink_to_fit();
+    }
+
+    /* add v to the set */
+    void insert(const size_t v){
+        if (dense_){
+            uint64_t& word = words_[v >> 6];
+            uint64_t bit = uint64_t(1) << (v & 63);
+            size_ += !(word & bit);
+            word |= bit;
+            return;
+        }
+        auto it = std::lower_bound(elems_.begin(), elems_.end(), v);
+        if (it != elems_.end() && *it == v){
+            return;
+        }
+        elems_.insert(it, v);
+        size_ += 1;
+        if (!is_small(size_)){
+            make_dense();
+        }
+    }
+
+    /* union */
+    VertexSet& operator|=(const VertexSet& other){
+        if (!dense_ && !other.dense_){
+            std::vector<size_t> elems;
+            elems.reserve(size_ + other.size_);
+            std::set_union(elems_.begin(), elems_.end(), other.elems_.begin(), other.elems_.end(), std::back_inserter(elems));
+            elems_.swap(elems);
+            size_ = elems_.size();
+            if (!is_small(size_)){
+                make_dense();
+            }
+            return *this;
+        }
+        make_dense();
+        if (other.dense_){
+            for (size_t i = 0; i < words_.size(); i++){
+                words_[i] |= other.words_[i];
+            }
+            count();
+        }
+        else{
+            for (auto v : other.elems_){
+                insert(v);
+            }
+        }
+        return *this;
+    }
+
+    /* intersection */
+    VertexSet& operator&=(const VertexSet& other){
+        if (dense_ && other.dense_){
+            for (size_t i = 0; i < words_.size(); i++){
+                words_[i] &= other.words_[i];
+            }
+            count();
+            return *this;
+        }
+        /* the result is not larger than the sparse set */
+        const VertexSet& small = dense_ ? other : *this;
+        const VertexSet& large = dense_ ? *this : other;
+        std::vector<size_t> elems;
+        for (auto v : small.elems_){
+            if (large.contains(v)){
+                elems.push_back(v);
+            }
+        }
+        clear();
+        elems_.swap(elems);
+        size_ = elems_.size();
+        return *this;
+    }
+
+    /* difference */
+    VertexSet& operator-=(const VertexSet& other){
+        if (!dense_){
+            std::vector<size_t> elems;
+            for (auto v : elems_){
+                if (!other.contains(v)){
+                    elems.push_back(v);
+                }
+            }
+            elems_.swap(elems);
+            size_ = elems_.size();
+        }
+        else if (other.dense_){
+            for (size_t i = 0; i < words_.size(); i++){
+                words_[i] &= ~other.words_[i];
+            }
+            count();
+        }
+        else{
+            for (auto v : other.elems_){
+                uint64_t& word = words_[v >> 6];
+                uint64_t bit = uint64_t(1) << (v & 63);
+                size_ -= (word & bit) != 0;
+                word &= ~bit;
+            }
+        }
+        return *this;
+    }
+
+    friend VertexSet operator|(VertexSet set1, const VertexSet& set2){
+        set1 |= set2;
+        return set1;
+    }
+    friend VertexSet operator&(VertexSet set1, const VertexSet& set2){
+        set1 &= set2;
+        return set1;
+    }
+    friend VertexSet operator-(VertexSet set1, const VertexSet& set2){
+        set1 -= set2;
+        return set1;
+    }
+
+    /* check if the set is included in other */
+    bool is_subset_of(const VertexSet& other) const {
+        if (dense_ && other.dense_){
+            for (size_t i = 0; i < words_.size(); i++){
+                if (words_[i] & ~other.words_[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+        for (auto v : *this){
+            if (!other.contains(v)){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* check if there is nonempty intersection between the two sets */
+    bool intersects(const VertexSet& other) const {
+        if (dense_ && other.dense_){
+            for (size_t i = 0; i < words_.size(); i++){
+                if (words_[i] & other.words_[i]){
+                    return true;
+                }
+            }
+            return false;
+        }
+        const VertexSet& small = dense_ ? other : *this;
+        const VertexSet& large = dense_ ? *this : other;
+        for (auto v : small.elems_){
+            if (large.contains(v)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* remove all elements (back to the sparse representation) */
+    void clear(){
+        size_ = 0;
+        dense_ = false;
+        words_.clear();
+        elems_.clear();
+    }
+
+    /* if a set with k elements is stored as a sorted vector */
+    bool is_small(const size_t k) const {
+        return k <= (n_ >> 6);
+    }
+
+    /* recompute the number of elements of a dense set */
+    void count(){
+        size_ = 0;
+        for (auto word : words_){
+            size_ += std::popcount(word);
+        }
+    }
+}; /* close class definition */
+} /* close namespace */
+
+#endif
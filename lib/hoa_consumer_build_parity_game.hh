@@ -18,9 +18,11 @@
 #include <stack>
 #include <cstring>
 #include <string>
+#include <algorithm>
 
 #include "cpphoafparser/consumer/hoa_consumer.hh"
 #include "cpphoafparser/parser/hoa_parser.hh"
+#include "EdgeLabel.hpp"
 
 #define V0 0 /* vertices belonging to player 0 */
 #define V1 1 /* vertices belonging to player 1 */
@@ -32,9 +34,9 @@ namespace cpphoafparser {
 
     struct parity_game_data {
         /* number of vertices */
-        size_t n_vert;
+        size_t n_vert = 0;
         /* number of edges */
-        size_t n_edge;
+        size_t n_edge = 0;
         /* vertices */
         std::set<size_t> vertices;
         /* vertex id: V0, when the vertex belongs to player 0 and V1 when it belongs to player 1 */
@@ -42,28 +44,28 @@ namespace cpphoafparser {
         /* edges as a map from vertices to set of its neighbours */
         std::map<size_t, std::set<size_t>> edges;
         /* number of colors */
-        size_t max_color;
+        size_t max_color = 0;
         /* colors of vertices */
         std::map<size_t, size_t> colors;
         /* vector of colors of vertices for multi-objective games */
         std::vector<std::map<size_t, size_t>> all_colors;
+        /* number of times all_colors was restarted for a different number of colors (only used to merge the
+         * data of blocks of states, see merge_parity_game_data) */
+        size_t all_colors_restarts = 0;
 
-        /* pre of edges for original vertices (incoming edges) */
-        std::map<size_t, std::set<size_t>> pre_edges;
-        
         /* initial vertex */
-        size_t init_vert;
+        size_t init_vert = 0;
         /* ids of atomic proposition */
         std::map<size_t, std::string> ap_id;
-        /* labels of edges (mid-states) */
-        std::map<size_t, std::vector<size_t>> labels;
+        /* labels of edges (mid-states) as packed (care, value) masks */
+        std::map<size_t, mpa::EdgeLabel> labels;
         /* controllable APs */
         std::set<size_t> controllable_ap;
         /* names of states */
         std::map<size_t, std::string> state_names;
         
         std::string acc_name;
-        size_t minCol;
+        size_t minCol = 0;
     };
 
     /**
@@ -218,6 +220,7 @@ namespace cpphoafparser {
                 }
                 if (all_color.size() > 0 && all_color.size() != data_->all_colors.size()){
                     data_->all_colors = std::vector<std::map<size_t, size_t>>(all_color.size());
+                    data_->all_colors_restarts += 1;
                 }    
             }
             else{
@@ -287,6 +290,7 @@ namespace cpphoafparser {
                 }
                 if (all_color.size() > 0 && all_color.size() != data_->all_colors.size()){
                     data_->all_colors = std::vector<std::map<size_t, size_t>>(all_color.size());
+                    data_->all_colors_restarts += 1;
                 }
                 
                 
@@ -304,14 +308,12 @@ namespace cpphoafparser {
                 data_->vert_id[newId] = 2;
                 data_->edges[stateId].insert(newId);
                 data_->edges[newId].insert(nbrId);
-                data_->pre_edges[nbrId].insert(newId);
                 data_->colors.insert({newId,color});
                 for (size_t i = 0; i < all_color.size(); i++){
                     data_->all_colors[i].insert({newId,all_color[i]});
                 }
                 
-                std::vector<size_t> edgeLabel(data_->ap_id.size(),2);
-                data_->labels.insert({newId, edgeLabel});
+                data_->labels.insert({newId, mpa::EdgeLabel(data_->ap_id.size())});
             }else{
                 std::stack<label_expr::ptr> conjunct_only_nodes;
                 while (nodes.size() != 0) {
@@ -337,13 +339,12 @@ namespace cpphoafparser {
                     data_->vert_id[newId] = 2;
                     data_->edges[stateId].insert(newId);
                     data_->edges[newId].insert(nbrId);
-                    data_->pre_edges[nbrId].insert(newId);
                     data_->colors.insert({newId,color});
                     for (size_t i = 0; i < all_color.size(); i++){
                         data_->all_colors[i].insert({newId,all_color[i]});
                     }
 
-                    std::vector<size_t> edgeLabel(data_->ap_id.size(),2);
+                    mpa::EdgeLabel edgeLabel(data_->ap_id.size());
                     while (single_node.size() != 0) {
                         label_expr::ptr curr_node = single_node.top();
                         single_node.pop();
@@ -352,13 +353,13 @@ namespace cpphoafparser {
                             single_node.push(curr_node->getRight());
                         } else if (curr_node->isNOT()){
                             unsigned int atom_id = curr_node->getLeft()->getAtom().getAPIndex();
-                            edgeLabel[atom_id] = 0;
+                            edgeLabel.set(atom_id, mpa::NEG);
                         } else if (curr_node->isAtom()){
                             unsigned int atom_id = curr_node->getAtom().getAPIndex();
-                            edgeLabel[atom_id] = 1;
+                            edgeLabel.set(atom_id, mpa::POS);
                         }
                     }
-                    data_->labels[newId] = edgeLabel;
+                    data_->labels[newId] = std::move(edgeLabel);
                 }
             }
         }
@@ -380,6 +381,135 @@ namespace cpphoafparser {
         std::ostream &out;
     };
 
+    /* shift the key of a node of a map or set by offset */
+    template<class Node>
+    void shift_key(Node& node, const size_t offset){
+        if constexpr (requires { node.key(); }){
+            node.key() += offset;
+        }
+        else {
+            node.value() += offset;
+        }
+    }
+
+    /* move the elements of block to data, where the keys from first are shifted by offset (they have to be
+     * larger than the keys of data after the shift); the elements with other keys that are already in data
+     * stay in block (as for repeated insertions into data) */
+    template<class Container>
+    void merge_shifted(Container& data, Container& block, const size_t first, const size_t offset){
+        for (auto it = block.lower_bound(first); it != block.end();){
+            auto node = block.extract(it++);
+            shift_key(node, offset);
+            data.insert(data.end(), std::move(node));
+        }
+        data.merge(block);
+    }
+
+    /* move the data of a block of State: definitions parsed after data (with the header of data), whose
+     * mid-states are numbered from n_states, to data (the mid-states are numbered after the ones of data) */
+    inline void merge_parity_game_data(parity_game_data& data, parity_game_data& block, const size_t n_states){
+        const size_t offset = data.n_vert - n_states;
+        data.n_vert += block.n_vert - n_states;
+        data.n_edge += block.n_edge;
+        data.max_color = std::max(data.max_color, block.max_color);
+        merge_shifted(data.vertices, block.vertices, n_states, offset);
+        merge_shifted(data.vert_id, block.vert_id, n_states, offset);
+        /* the successors of the states are mid-states */
+        for (auto& pair : block.edges){
+            if (pair.first >= n_states){
+                break;
+            }
+            std::set<size_t> succ;
+            merge_shifted(succ, pair.second, n_states, offset);
+            pair.second = std::move(succ);
+        }
+        merge_shifted(data.edges, block.edges, n_states, offset);
+        for (auto& pair : block.edges){ /* states defined again */
+            data.edges[pair.first].merge(pair.second);
+        }
+        merge_shifted(data.colors, block.colors, n_states, offset);
+        /* the colors of all games restart whenever the number of colors changes */
+        if (block.all_colors_restarts == 1 && block.all_colors.size() == data.all_colors.size()){
+            for (size_t i = 0; i < data.all_colors.size(); i++){
+                merge_shifted(data.all_colors[i], block.all_colors[i], n_states, offset);
+            }
+        }
+        else if (block.all_colors_restarts > 0){
+            data.all_colors = std::vector<std::map<size_t, size_t>>(block.all_colors.size());
+            for (size_t i = 0; i < data.all_colors.size(); i++){
+                merge_shifted(data.all_colors[i], block.all_colors[i], n_states, offset);
+            }
+            data.all_colors_restarts += block.all_colors_restarts;
+        }
+        merge_shifted(data.labels, block.labels, n_states, offset);
+        merge_shifted(data.state_names, block.state_names, n_states, offset);
+    }
+
+    /* parse the parity game in the hoa text [text,text+size) without validity checks (for trusted inputs):
+     * the body is split into (at most n_blocks) blocks of State: definitions that are parsed concurrently,
+     * each into its own data whose mid-states are numbered from the number of states, and the blocks are
+     * merged in order, so that the data is the same as with HOAParser::parse; returns false if the text is
+     * not parsed this way (the data is then incomplete, and errors are reported by HOAParser::parse) */
+    inline bool parse_parity_game_blocks(const char* text, const size_t size, const size_t n_blocks, parity_game_data& data){
+        size_t body;
+        try {
+            HOAConsumer::ptr consumer(new HOAConsumerBuildParityGame(&data));
+            body = HOAParser::parseHeader(text, size, consumer);
+        }
+        catch (...){
+            return false;
+        }
+        /* the blocks start at lines beginning with State: (a line of a string or a comment that begins
+         * with State: makes the block before it fail) */
+        const std::string state_line = "\nState:";
+        std::vector<size_t> bounds(1, body);
+        const size_t step = std::max<size_t>(1, (size - body) / std::max<size_t>(1, n_blocks));
+        for (size_t b = 1; b < n_blocks; b++){
+            const char* from = text + std::max(body + b * step, bounds.back());
+            const char* found = std::search(from, text + size, state_line.begin(), state_line.end());
+            if (found == text + size){
+                break;
+            }
+            if (size_t(found - text) + 1 > bounds.back()){
+                bounds.push_back(found - text + 1);
+            }
+        }
+        bounds.push_back(size);
+
+        const size_t n_states = data.n_vert;
+        std::vector<parity_game_data> blocks(bounds.size() - 1);
+        std::vector<char> parsed(blocks.size(), true);
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t b = 0; b < blocks.size(); b++){
+            parity_game_data& block = blocks[b];
+            block.n_vert = n_states;
+            block.max_color = data.max_color;
+            block.minCol = data.minCol;
+            block.ap_id = data.ap_id;
+            try {
+                HOAConsumer::ptr consumer(new HOAConsumerBuildParityGame(&block));
+                HOAParser::parseStates(text + bounds[b], bounds[b+1] - bounds[b], consumer, b + 1 == blocks.size());
+            }
+            catch (...){
+                parsed[b] = false;
+            }
+            /* the states and their successors have to be distinguished from the mid-states */
+            for (const auto& pair : block.state_names){
+                parsed[b] = parsed[b] && pair.first < n_states;
+            }
+            for (auto it = block.edges.lower_bound(n_states); it != block.edges.end(); ++it){
+                parsed[b] = parsed[b] && *it->second.rbegin() < n_states;
+            }
+        }
+        for (size_t b = 0; b < blocks.size(); b++){
+            if (!parsed[b]){
+                return false;
+            }
+            merge_parity_game_data(data, blocks[b], n_states);
+        }
+        return true;
+    }
+
 }// namespace cpphoafparser
 
 #endif
\ No newline at end of file
@@ -5,6 +5,10 @@
  *  It reuires stdin input as which is the description of a (generalized) parity game in extended HOA or pgsolver format; and outputs the result to stdout */
 
 #include "FileHandler.hpp"
+#include <chrono>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 void printHelpN(const std::string str) {
         std::cout << "pestel " << str << " is not available.\n";
@@ -17,12 +21,19 @@ void printHelp() {
     std::cout << "- STDIN: description of a parity game in extended-HOA/pgsolver format or description of a generalized parity game in pgsolver format\n";
     std::cout << "- STDOUT: a winning strategy template\n"; 
     std::cout << "\nThe possible OPTIONs are as follows:\n";
+    std::cout << "- --compress-colors       Compress the colors of every objective before solving (the template does not change)\n";
     std::cout << "- --help                  Print this help message\n";
+    std::cout << "- --input FILE            Read the game from FILE (mapped into memory and parsed in parallel) instead of STDIN\n";
     std::cout << "- --localize              Print only a local template for each state in JSON format\n";
     std::cout << "- --print-actions         Print the template with actions instead of edges (only for games with labels on edges)\n";
     std::cout << "- --print-game            Print the parity game (same format as input)\n";
     std::cout << "- --print-game=pg         Print the parity game in pgsolver format\n";
     std::cout << "- --print-template-size   Print size of the templates\n";
+    std::cout << "- --print-time            Print the number of threads and the time for computing the template\n";
+    std::cout << "- --scc                   Solve the games bottom-up along the strongly connected components of the game graph (the template and partial winning region of generalized parity games may change)\n";
+    std::cout << "- --sliced                Solve all objectives of generalized parity games together (64 per machine word)\n";
+    std::cout << "- --threads N             Solve the games with N threads (default: number of cores)\n";
+    std::cout << "- --trusted-input         Skip the validity checks of games in extended-HOA format (only the syntax is checked)\n";
     std::cout << "\nExample usage:\n";
     std::cout << "pestel --print-template-size < example.pg\n";
 }
@@ -34,6 +45,12 @@ int main(int argc, char* argv[]) {
         bool print_template_size = false; // Flag to determine if template size should be printed
         bool print_actions = false; // Flag to determine if labels should be printed
         bool localize = false; // Flag to determine if only local templates should be printed
+        bool compress_colors = false; // Flag to determine if colors should be compressed before solving
+        bool scc = false; // Flag to determine if games should be solved by SCC decomposition
+        bool sliced = false; // Flag to determine if the objectives should be solved together by bit-slicing
+        bool print_time = false; // Flag to determine if the solving time should be printed
+        bool trusted_input = false; // Flag to determine if the validity checks of HOA games should be skipped
+        std::string input; // File to read the game from (empty for stdin)
 
         for (int i = 1; i < argc; ++i) {
             if (std::string(argv[i]) == "--print-game") {
@@ -46,6 +63,28 @@ int main(int argc, char* argv[]) {
                 print_actions = true;   
             } else if (std::string(argv[i]) == "--localize") {
                 localize = true;
+            } else if (std::string(argv[i]) == "--compress-colors") {
+                compress_colors = true;
+            } else if (std::string(argv[i]) == "--scc") {
+                scc = true;
+            } else if (std::string(argv[i]) == "--sliced") {
+                sliced = true;
+            } else if (std::string(argv[i]) == "--print-time") {
+                print_time = true;
+            } else if (std::string(argv[i]) == "--trusted-input") {
+                trusted_input = true;
+            } else if (std::string(argv[i]) == "--input" && i+1 < argc) {
+                input = argv[++i];
+            } else if (std::string(argv[i]) == "--threads" && i+1 < argc) {
+                int n_threads = std::stoi(argv[++i]);
+                if (n_threads < 1) {
+                    throw std::runtime_error("[ERROR] --threads: the number of threads should be positive.");
+                }
+#ifdef _OPENMP
+                omp_set_num_threads(n_threads);
+#else
+                std::cerr << "[WARNING] pestel is compiled without OpenMP, --threads is ignored.\n";
+#endif
             } else if (std::string(argv[i]) == "--help") {
                 printHelp();
                 return 0;
@@ -55,8 +94,8 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        /* construct games from stdin */
-        mpa::MultiGame G = std2multigame();
+        /* construct games from the input file or stdin */
+        mpa::MultiGame G = input.empty() ? std2multigame(!trusted_input) : mapped2multigame(input, !trusted_input);
 
         /* print the game if print_game or print_game_pg is true */
         if (print_game_pg){
@@ -67,14 +106,22 @@ int main(int argc, char* argv[]) {
             std::cout << "\n===================================================\n";
         }
         
+        /* compress the colors (after printing the game, the template is on the same vertices) */
+        std::pair<size_t, size_t> n_colors;
+        if (compress_colors){
+            n_colors = G.compress_priorities();
+        }
+
         /* compute the strat template */
         std::pair<std::set<size_t>, std::set<size_t>> winning_region;
 
         mpa::Template strat;
-        winning_region = G.find_composition_template(strat);
+        auto start = std::chrono::steady_clock::now();
+        winning_region = G.find_composition_template(strat, scc, sliced);
         strat.clean();
+        auto solve_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
         /* remove edge-states from result (needned for HOA formatted games) */
-        G.filter_out_edge_states(winning_region, strat, print_actions);
+        G.filter_out_edge_states(winning_region, strat);
 
         /* if localize is true then print only local templates in JSON format and exit */
         if (localize){
@@ -86,19 +133,32 @@ int main(int argc, char* argv[]) {
         if (G.n_games_ > 1) {
             str_win = "(Partial) Winning Region";
         }
-        G.print_set(winning_region.first, str_win);
+        G.print_set(G.original_ids(winning_region.first), str_win);
 
         /* print the strategy template with edges if print_actions is false else with labels */
-        strat.print_template();
+        G.print_template(strat, print_actions);
         std::cout << "*===================================================\n";
         
         /* print the size of the templates if print_template_size is true */
         if (print_template_size){
             std::cout << "\n#winning_vertices:"<< winning_region.first.size()<< "/"<<winning_region.first.size()+winning_region.second.size()<<"\n";
-            strat.print_size();
+            G.print_template_size(strat);
+            if (compress_colors){
+                std::cout << "#colors_after_compression:"<< n_colors.second << "/" << n_colors.first << "\n";
+            }
             std::cout <<"**==================================================\n";
         }
 
+        /* print the number of threads and the solving time if print_time is true */
+        if (print_time){
+#ifdef _OPENMP
+            std::cout << "#threads:" << omp_get_max_threads() << "\n";
+#else
+            std::cout << "#threads:1\n";
+#endif
+            std::cout << "#solve_time_ms:" << solve_time.count() << "\n";
+        }
+
         if (winning_region.first.find(G.init_vert_) != winning_region.first.end()){
             std::cout << "REALIZABLE!\n";
             return 0;